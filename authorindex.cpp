@@ -0,0 +1,103 @@
+//============================================================================
+// Name         : authorindex.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Inverted index from normalized author names to books
+//============================================================================
+#include "authorindex.h"
+using namespace std;
+
+//Function to normalize an author name so that case, dots and extra spaces do not matter
+string AuthorIndex::normalize(const string& name){
+    string key;
+    key.reserve(name.size());
+    bool pendingSpace = false;
+    for (size_t i = 0; i < name.size(); i++){
+        unsigned char c = name[i];
+        //Treat dots and white space as word separators
+        if (c == ' ' || c == '\t' || c == '.'){
+            pendingSpace = !key.empty();
+            continue;
+        }
+        //Write a single space between words (never at the start or the end)
+        if (pendingSpace){
+            key += ' ';
+            pendingSpace = false;
+        }
+        key += (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : (char)c;
+    }
+    return key;
+}
+
+//Constructor for the authors of a catalog
+AuthorIndex::AuthorIndex(const StringPool* authorNames){
+    this->authorNames = authorNames;
+}
+
+//Function to find the posting list of an author id
+int AuthorIndex::keyOf(unsigned int authorId){
+    //Interned names are normalized only once, however many books they have
+    while (keyOfAuthor.size() <= (int)authorId){
+        keyOfAuthor.push_back(-1);
+    }
+    int key = keyOfAuthor[authorId];
+    if (key < 0){
+        string normalized = normalize(authorNames->str(authorId));
+        int* existing = keys.find(normalized);
+        if (existing){
+            key = *existing;
+        } else {
+            key = postings.size();
+            postings.emplace_back();
+            keys.insert(normalized, key);
+        }
+        keyOfAuthor[authorId] = key;
+    }
+    return key;
+}
+
+//Function to add a book to the posting list of its author
+void AuthorIndex::add(Book* book){
+    MyVector<Book*>& list = postings[keyOf(book->authorId)];
+    book->authorSlot = list.size();
+    list.push_back(book);
+}
+
+//Function to remove a book from the posting list of its author
+void AuthorIndex::remove(Book* book){
+    //If the book is not indexed, then there is nothing to do
+    if (book->authorSlot < 0){
+        return;
+    }
+    //Move the last book of the list into the slot of the removed one
+    MyVector<Book*>& list = postings[keyOf(book->authorId)];
+    Book* last = list[list.size() - 1];
+    list[book->authorSlot] = last;
+    last->authorSlot = book->authorSlot;
+    list.pop_back();
+    book->authorSlot = -1;
+}
+
+//Function to remove every book from the index
+void AuthorIndex::clear(){
+    for (int i = 0; i < postings.size(); i++){
+        for (int j = 0; j < postings[i].size(); j++){
+            postings[i][j]->authorSlot = -1;
+        }
+    }
+    //The ids of the author names are no longer valid once the catalog is cleared
+    postings.clear();
+    keys.clear();
+    keyOfAuthor.clear();
+}
+
+//Function to return the books of an author
+const MyVector<Book*>* AuthorIndex::find(const string& name) const {
+    const int* key = keys.find(normalize(name));
+    if (!key || postings[*key].empty()){
+        return nullptr;
+    }
+    return &postings[*key];
+}
@@ -0,0 +1,39 @@
+//============================================================================
+// Name         : authorindex.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : header file for authorindex.cpp
+//============================================================================
+#ifndef _AUTHORINDEX_H
+#define _AUTHORINDEX_H
+
+#include <string>
+#include "myvector.h"
+#include "myhashmap.h"
+#include "book.h"
+
+//Inverted index from the normalized name of an author to the books of that author
+class AuthorIndex
+{
+	private:
+		MyHashMap<std::string, int> keys;			//normalized author name -> number of its posting list
+		const StringPool* authorNames;				//author names of the catalog (not locked: callers hold the catalog lock, as a reader at least)
+		MyVector<int> keyOfAuthor;					//author id (in authorNames) -> number of its posting list, -1 if not known yet
+		MyVector<MyVector<Book*> > postings;		//posting lists; a book knows its position in its list (Book::authorSlot)
+
+		int keyOf(unsigned int authorId);			//return the posting list of an author, creating it if needed
+
+	public:
+		explicit AuthorIndex(const StringPool* authorNames);
+
+		static std::string normalize(const std::string& name);	//lower-case the name and collapse its spaces (also drops '.' so "J.R.R." matches "J R R")
+
+		void add(Book* book);						//add a book to the list of its author
+		void remove(Book* book);					//remove a book from the list of its author (the author must not have changed since add)
+		void clear();								//remove every book and forget every author (call it when authorNames is cleared)
+		const MyVector<Book*>* find(const std::string& name) const;	//return the books of an author, nullptr if there are none
+};
+
+#endif
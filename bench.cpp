@@ -0,0 +1,490 @@
+//============================================================================
+// Name         : bench.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Benchmark harness timing the hot paths of LCMS on a synthetic catalog
+//============================================================================
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "lcms.h"
+#include "cataloggen.h"
+#include "myvector.h"
+
+using namespace std;
+
+//Stream buffer that drops everything, so the console output of the commands is not part of the timings
+class NullBuffer : public streambuf
+{
+	protected:
+		int overflow(int c) { return c; }
+		streamsize xsputn(const char*, streamsize n) { return n; }
+};
+
+//Settings of a benchmark run (see printUsage)
+struct BenchOptions
+{
+	CatalogShape shape;
+	int reps;				//timed repetitions of every benchmark
+	int warmup;				//untimed repetitions run first
+	int ops;				//calls per repetition of the per-call benchmarks
+	int threads;			//desks of the concurrent circulation checks
+	string catalogPath;		//generated catalog
+	string exportPath;		//target of exportData
+};
+
+static NullBuffer nullBuffer;
+static streambuf* consoleOut;
+static streambuf* consoleErr;
+
+//Function to send the console output of the commands to nullBuffer (quiet) or back to the console
+static void silence(bool quiet) {
+	cout.rdbuf(quiet ? &nullBuffer : consoleOut);
+	cerr.rdbuf(quiet ? &nullBuffer : consoleErr);
+}
+
+//Function to return the time since start in microseconds
+static double microsecondsSince(chrono::steady_clock::time_point start) {
+	return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count() / 1e3;
+}
+
+//Function to print one row of the report: mean and percentiles of the samples (in microseconds)
+static void report(const string& name, vector<double>& samples) {
+	if (samples.empty()) {
+		return;
+	}
+	sort(samples.begin(), samples.end());
+	double sum = 0;
+	for (size_t i = 0; i < samples.size(); i++) {
+		sum += samples[i];
+	}
+	//Nearest-rank percentile
+	auto percentile = [&samples](double p) {
+		size_t rank = (size_t)(p / 100.0 * samples.size() + 0.999999);
+		return samples[rank == 0 ? 0 : min(rank, samples.size()) - 1];
+	};
+	cout << left << setw(24) << name << right << setw(9) << samples.size()
+		 << setw(13) << sum / samples.size() << setw(13) << percentile(50) << setw(13) << percentile(90)
+		 << setw(13) << percentile(99) << setw(13) << samples.back() << endl;
+}
+
+//Function to create a catalog and import the generated file into it
+static LCMS* loadCatalog(const BenchOptions& options) {
+	LCMS* lcms = new LCMS("Library");
+	silence(true);
+	lcms->import(options.catalogPath);
+	silence(false);
+	return lcms;
+}
+
+//Function to time a whole-catalog operation once per repetition (after the warm-up repetitions)
+template <typename Setup, typename Run>
+static void timeRepetitions(const string& name, const BenchOptions& options, Setup setup, Run run) {
+	vector<double> samples;
+	for (int rep = 0; rep < options.warmup + options.reps; rep++) {
+		LCMS* lcms = setup();
+		silence(true);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		run(lcms);
+		double elapsed = microsecondsSince(start);
+		silence(false);
+		delete lcms;
+		if (rep >= options.warmup) {
+			samples.push_back(elapsed);
+		}
+	}
+	report(name, samples);
+}
+
+//Function to time every call of a per-call operation (after the warm-up rounds)
+template <typename Call>
+static void timeCalls(const string& name, const BenchOptions& options, int ops, CatalogGenerator& random, Call call) {
+	vector<double> samples;
+	samples.reserve((size_t)ops * options.reps);
+	silence(true);
+	for (int round = 0; round < options.warmup + options.reps; round++) {
+		for (int i = 0; i < ops; i++) {
+			int pick = random.nextInt(1 << 30);
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			call(pick, i);
+			double elapsed = microsecondsSince(start);
+			if (round >= options.warmup) {
+				samples.push_back(elapsed);
+			}
+		}
+	}
+	silence(false);
+	report(name, samples);
+}
+
+//Function to run borrow/return cycles on several threads and check that every copy came back
+static void concurrentCirculation(LCMS& lcms, CatalogGenerator& generator, const BenchOptions& options) {
+	int books = generator.getShape().books;
+	int perThread = options.ops / options.threads;
+	atomic<long long> failures(0);
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	vector<thread> workers;
+	for (int t = 0; t < options.threads; t++) {
+		workers.push_back(thread([&, t]() {
+			//Each thread picks its books with its own generator, so the run is the same every time
+			CatalogShape shape = generator.getShape();
+			shape.seed += t + 1;
+			shape.depth = 1;
+			shape.fanout = 1;
+			CatalogGenerator random(shape);
+			string name = "Desk " + to_string(t);
+			for (int i = 0; i < perThread; i++) {
+				string title = generator.title(random.nextInt(books));
+				string id = to_string(i % 100);
+				if (lcms.borrowBook(title, name, id) == CATALOG_OK && lcms.returnBook(title, name, id) != CATALOG_OK) {
+					failures++;
+				}
+			}
+		}));
+	}
+	for (size_t t = 0; t < workers.size(); t++) {
+		workers[t].join();
+	}
+	double elapsed = microsecondsSince(start);
+
+	//Every copy that was lent has been returned, so every book must have all its copies again
+	long long missing = 0;
+	for (int book = 0; book < books; book++) {
+		BookInfo info;
+		if (lcms.getBook(generator.title(book), info) == CATALOG_OK && info.availableCopies != info.totalCopies) {
+			missing++;
+		}
+	}
+	cout << "Concurrent borrow/return: " << options.threads << " threads, " << (long long)perThread * options.threads
+		 << " cycles in " << elapsed / 1e3 << " ms (" << perThread * options.threads / (elapsed / 1e6) << " cycles/s), "
+		 << (failures == 0 && missing == 0 ? "consistent" : "INCONSISTENT") << " (" << failures << " failed returns, "
+		 << missing << " books missing copies)" << endl;
+}
+
+//Function to run desks that borrow and return at random against shared and private books, keeping some loans open,
+//then check that the loan lists of the books and borrowers match the counts of the desks and that the available
+//copies stayed within [0, total copies] during the run
+static void circulationStress(LCMS& lcms, CatalogGenerator& generator, const BenchOptions& options) {
+	int books = generator.getShape().books;
+	int desks = options.threads;
+	int perDesk = options.ops / desks;
+	//Every desk works on the same few hot books and on a range of books of its own
+	int hot = min(4, books);
+	int own = max(1, min(64, (books - hot) / desks));
+	auto bookOf = [&](int desk, int pick) {
+		return pick < hot || books - hot < desks ? pick % books : hot + desk * own + (pick - hot) % own;
+	};
+
+	//Copies and loans before the run, so the check does not depend on earlier benchmarks
+	vector<int> totals(books, 0), availableBefore(books, 0), borrowersBefore(books, 0);
+	vector<unsigned char> checked(books, 0);
+	for (int desk = 0; desk < desks; desk++) {
+		for (int pick = 0; pick < hot + own; pick++) {
+			int book = bookOf(desk, pick);
+			BookInfo info;
+			if (!checked[book] && lcms.getBook(generator.title(book), info) == CATALOG_OK) {
+				checked[book] = 1;
+				totals[book] = info.totalCopies;
+				availableBefore[book] = info.availableCopies;
+				lcms.getBorrowerCount(generator.title(book), borrowersBefore[book]);
+			}
+		}
+	}
+
+	//Desks record what they lent and still hold; a monitor samples the hot books while they run
+	vector<vector<int> > held(desks);
+	atomic<long long> lends(0), returns(0), failedReturns(0), outOfRange(0);
+	atomic<bool> running(true);
+	thread monitor([&]() {
+		while (running.load()) {
+			for (int book = 0; book < hot; book++) {
+				BookInfo info;
+				if (lcms.getBook(generator.title(book), info) == CATALOG_OK
+					&& (info.availableCopies < 0 || info.availableCopies > info.totalCopies)) {
+					outOfRange++;
+				}
+			}
+		}
+	});
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	vector<thread> workers;
+	for (int t = 0; t < desks; t++) {
+		workers.push_back(thread([&, t]() {
+			CatalogShape shape = generator.getShape();
+			shape.seed += 1000 + t;
+			shape.depth = 1;
+			shape.fanout = 1;
+			CatalogGenerator random(shape);
+			string name = "Stress desk " + to_string(t), id = to_string(t);
+			vector<int>& loans = held[t];
+			for (int i = 0; i < perDesk; i++) {
+				if (!loans.empty() && random.nextInt(2) == 0) {
+					//Return one of the copies the desk holds
+					int slot = random.nextInt((int)loans.size());
+					if (lcms.returnBook(generator.title(loans[slot]), name, id) == CATALOG_OK) {
+						returns++;
+					} else {
+						failedReturns++;
+					}
+					loans[slot] = loans.back();
+					loans.pop_back();
+				} else {
+					//Borrow a hot book or one of the desk's own (no copy left is not an error)
+					int book = bookOf(t, random.nextInt(2) == 0 ? random.nextInt(hot) : hot + random.nextInt(own));
+					if (lcms.borrowBook(generator.title(book), name, id) == CATALOG_OK) {
+						lends++;
+						loans.push_back(book);
+					}
+				}
+			}
+		}));
+	}
+	for (size_t t = 0; t < workers.size(); t++) {
+		workers[t].join();
+	}
+	double elapsed = microsecondsSince(start);
+	running = false;
+	monitor.join();
+
+	//Every copy still held by a desk must be on the loan lists of its book and of its borrower, and missing from the available copies
+	vector<int> outstanding(books, 0);
+	long long open = 0, mismatches = 0;
+	for (int t = 0; t < desks; t++) {
+		for (size_t i = 0; i < held[t].size(); i++) {
+			outstanding[held[t][i]]++;
+		}
+		open += held[t].size();
+		if (lcms.getLoanCount("Stress desk " + to_string(t), to_string(t)) != (int)held[t].size()) {
+			mismatches++;
+		}
+	}
+	for (int book = 0; book < books; book++) {
+		if (!checked[book]) {
+			continue;
+		}
+		BookInfo info;
+		int current = -1;
+		lcms.getBook(generator.title(book), info);
+		lcms.getBorrowerCount(generator.title(book), current);
+		if (current != borrowersBefore[book] + outstanding[book] || info.availableCopies != availableBefore[book] - outstanding[book]
+			|| info.availableCopies < 0 || info.availableCopies > totals[book]) {
+			mismatches++;
+		}
+	}
+	bool consistent = lends - returns == open && failedReturns == 0 && outOfRange == 0 && mismatches == 0;
+	cout << "Circulation stress: " << desks << " desks, " << lends << " lends, " << returns << " returns, " << open
+		 << " loans left open in " << elapsed / 1e3 << " ms, " << (consistent ? "consistent" : "INCONSISTENT") << " ("
+		 << failedReturns << " failed returns, " << mismatches << " loan count mismatches, " << outOfRange
+		 << " available counts out of range)" << endl;
+
+	//Give the copies back, so the catalog is as before for the next check
+	for (int t = 0; t < desks; t++) {
+		for (size_t i = 0; i < held[t].size(); i++) {
+			lcms.returnBook(generator.title(held[t][i]), "Stress desk " + to_string(t), to_string(t));
+		}
+	}
+}
+
+//Function to check that categories are found by path after they are moved and removed, also when two sibling
+//categories have the same name and the one left in the tree has to take over the paths of the removed one
+static void categoryPaths() {
+	int failures = 0;
+	LCMS lcms("Library");
+	silence(true);
+	BookInfo info = {"Path Check Book", "Path Author", "", 2000, 1, 1, "Old/Shelf"};
+	lcms.addBook(info);
+	lcms.createCategory("Old/Shelf/Inner");
+	if (lcms.moveCategory("Old", "New/Place") != CATALOG_OK || lcms.moveCategory("New", "New/Place/Loop") != CATALOG_INVALID_ARGUMENT) {
+		failures++;
+	}
+	silence(false);
+	if (lcms.hasCategory("Old") || lcms.hasCategory("Old/Shelf") || !lcms.hasCategory("New/Place/Shelf/Inner")
+		|| lcms.getBook("Path Check Book", info) != CATALOG_OK || info.category != "Library/New/Place/Shelf") {
+		failures++;
+	}
+
+	//Two sibling categories with the same path (in pre-order: root, Hall, first Shelf, its Box, second Shelf)
+	Tree tree("Library");
+	Node* hall = tree.createNode("Hall");
+	tree.insert(hall, "Shelf");
+	tree.createNode("Hall/Shelf/Box");
+	tree.insert(hall, "Shelf");
+	const MyVector<FlatNode>& nodes = tree.layout();
+	Node* second = nodes[nodes.size() - 1].node;
+	tree.insert(second, "Box");
+	//Removing the first one must leave its paths to the second one and its Box
+	tree.remove(hall, "Shelf");
+	if (tree.getNode("Hall/Shelf") != second || tree.getNode("Hall/Shelf/Box") != tree.getChild(second, "Box")
+		|| tree.getNode("Hall/Shelf/Box") == nullptr) {
+		failures++;
+	}
+	tree.remove(hall, "Shelf");
+	if (tree.getNode("Hall/Shelf") || tree.getNode("Hall/Shelf/Box") || tree.getNode("Hall") != hall) {
+		failures++;
+	}
+	cout << "Category paths: moves and removals with duplicate sibling names, "
+		 << (failures == 0 ? "consistent" : "INCONSISTENT") << " (" << failures << " failed checks)" << endl;
+}
+
+//Function to make durable changes in a child process that is then killed, and check that recovering from the
+//snapshot and journal it left behind restores every change (the journal is written with fsync before a change returns)
+static void crashRecovery(CatalogGenerator& generator, const BenchOptions& options) {
+	string snapshotPath = "bench_crash.snapshot", journalPath = "bench_crash.journal";
+	string addedTitle = "Crash Recovery Book", removedTitle = generator.title(1), borrowedTitle = generator.title(0);
+	remove(snapshotPath.c_str());
+	remove(journalPath.c_str());
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	pid_t child = fork();
+	if (child < 0) {
+		cerr << "Crash recovery: fork failed" << endl;
+		return;
+	}
+	if (child == 0) {
+		//Snapshot the catalog, change it with the journal open and die without closing anything
+		LCMS* lcms = loadCatalog(options);
+		silence(true);
+		BookInfo info = {addedTitle, "Crash Author", "978-0-306-40615-7", 2001, 2, 2, "Crash/Recovery"};
+		bool changed = lcms->saveSnapshot(snapshotPath) && lcms->openJournal(journalPath)
+			&& lcms->addBook(info) == CATALOG_OK && lcms->borrowBook(borrowedTitle, "Crash desk", "1") == CATALOG_OK
+			&& lcms->deleteBook(removedTitle) == CATALOG_OK;
+		if (!changed) {
+			_exit(EXIT_FAILURE);
+		}
+		kill(getpid(), SIGKILL);
+	}
+	int status = 0;
+	waitpid(child, &status, 0);
+	bool killed = WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL;
+
+	//Restart: a new catalog recovers from what the killed process left on disk
+	LCMS lcms("Library");
+	silence(true);
+	bool recovered = killed && lcms.recover(snapshotPath, journalPath);
+	silence(false);
+	BookInfo info;
+	bool consistent = recovered && lcms.getBook(addedTitle, info) == CATALOG_OK && info.author == "Crash Author"
+		&& lcms.getLoanCount("Crash desk", "1") == 1 && lcms.getBook(removedTitle, info) == CATALOG_NOT_FOUND
+		&& lcms.getBook(generator.title(2), info) == CATALOG_OK;
+	double elapsed = microsecondsSince(start);
+	cout << "Crash recovery: " << (killed ? "killed after 3 durable changes" : "child did not reach the kill") << ", restart in "
+		 << elapsed / 1e3 << " ms, " << (consistent ? "consistent" : "INCONSISTENT") << endl;
+
+	remove(snapshotPath.c_str());
+	remove(journalPath.c_str());
+}
+
+//Function to display how to run the benchmarks
+static void printUsage(const char* program) {
+	cerr << "Usage: " << program << " [options]" << endl
+		 << "  --books <n>        books in the generated catalog (default 100000)" << endl
+		 << "  --depth <n>        levels of categories (default 3)" << endl
+		 << "  --fanout <n>       sub-categories per category (default 8)" << endl
+		 << "  --seed <n>         seed of the generator (default 42)" << endl
+		 << "  --reps <n>         timed repetitions (default 5)" << endl
+		 << "  --warmup <n>       untimed repetitions run first (default 1)" << endl
+		 << "  --ops <n>          calls per repetition of the per-call benchmarks (default 20000)" << endl
+		 << "  --threads <n>      desks of the concurrent circulation checks (default 4)" << endl
+		 << "  --generate <file>  only write the generated catalog to file" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+	BenchOptions options = {{100000, 3, 8, 42}, 5, 1, 20000, 4, "bench_catalog.csv", "bench_export.csv"};
+	string generateOnly;
+	consoleOut = cout.rdbuf();
+	consoleErr = cerr.rdbuf();
+
+	//Parse the options
+	for (int i = 1; i < argc; i++) {
+		if (i + 1 >= argc) {
+			printUsage(argv[0]);
+			return EXIT_FAILURE;
+		}
+		string option = argv[i], value = argv[++i];
+		if (option == "--generate") {
+			generateOnly = value;
+			continue;
+		}
+		long long number = atoll(value.c_str());
+		if (option == "--books") options.shape.books = (int)number;
+		else if (option == "--depth") options.shape.depth = (int)number;
+		else if (option == "--fanout") options.shape.fanout = (int)number;
+		else if (option == "--seed") options.shape.seed = (unsigned long long)number;
+		else if (option == "--reps") options.reps = (int)number;
+		else if (option == "--warmup") options.warmup = (int)number;
+		else if (option == "--ops") options.ops = (int)number;
+		else if (option == "--threads") options.threads = (int)number;
+		else {
+			printUsage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (options.shape.books < 1 || options.reps < 1 || options.warmup < 0 || options.ops < 1 || options.threads < 1) {
+		printUsage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	//Generate the catalog
+	CatalogGenerator generator(options.shape);
+	if (!generateOnly.empty()) {
+		return generator.writeCsv(generateOnly) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	if (!generator.writeCsv(options.catalogPath)) {
+		return EXIT_FAILURE;
+	}
+	const CatalogShape& shape = generator.getShape();
+	const MyVector<string>& categories = generator.categoryPaths();
+	cout << "Catalog: " << shape.books << " books, " << categories.size() << " categories (depth " << shape.depth
+		 << ", fanout " << shape.fanout << "), seed " << shape.seed << endl;
+	cout << "Repetitions: " << options.reps << " timed after " << options.warmup << " warm-up, " << options.ops << " calls each" << endl << endl;
+	cout << fixed << setprecision(2);
+	cout << left << setw(24) << "benchmark (us)" << right << setw(9) << "samples" << setw(13) << "mean" << setw(13) << "p50"
+		 << setw(13) << "p90" << setw(13) << "p99" << setw(13) << "max" << endl;
+
+	//Whole-catalog operations, one sample per repetition
+	timeRepetitions("import", options, [&]() { return new LCMS("Library"); },
+					[&](LCMS* lcms) { lcms->import(options.catalogPath); });
+	timeRepetitions("exportData", options, [&]() { return loadCatalog(options); },
+					[&](LCMS* lcms) { lcms->exportData(options.exportPath); });
+	int removed = 0;
+	timeRepetitions("removeCategory", options, [&]() { return loadCatalog(options); },
+					[&](LCMS* lcms) { lcms->removeCategory(categories[removed++ % generator.topLevelCategories()]); });
+
+	//Per-call operations on one loaded catalog
+	LCMS* lcms = loadCatalog(options);
+	int books = shape.books;
+	timeCalls("findBook", options, options.ops, generator,
+			  [&](int pick, int) { lcms->findBook(generator.title(pick % books)); });
+	timeCalls("findAll", options, max(options.ops / 100, 10), generator,
+			  [&](int pick, int) { lcms->findAll(categories[pick % categories.size()]); });
+	timeCalls("borrowBook+returnBook", options, options.ops, generator, [&](int pick, int i) {
+		string title = generator.title(pick % books), id = to_string(i % 1000);
+		lcms->borrowBook(title, "Bench", id);
+		lcms->returnBook(title, "Bench", id);
+	});
+	cout << endl;
+	circulationStress(*lcms, generator, options);
+	concurrentCirculation(*lcms, generator, options);
+	delete lcms;
+	categoryPaths();
+	crashRecovery(generator, options);
+
+	remove(options.catalogPath.c_str());
+	remove(options.exportPath.c_str());
+	return EXIT_SUCCESS;
+}
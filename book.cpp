@@ -8,25 +8,46 @@
 //============================================================================S
 #include <iostream>
 #include "book.h"
-#include "lcms.h"
 using namespace std; 
 
 //Constructor
-Book::Book(std::string title, std::string author, std::string isbn, int publication_year, int total_copies, int available_copies) {
+Book::Book(std::string title, std::string author, std::string isbn, int publication_year, int total_copies, int available_copies, StringPool& authorNames)
+    : Book(title, authorNames.intern(author), isbn, publication_year, total_copies, available_copies) { //Author is stored once in the pool of author names
+}
+
+//Constructor for a book whose author is already in the pool of author names
+Book::Book(std::string title, unsigned int authorId, std::string isbn, int publication_year, int total_copies, int available_copies) {
     //Assign parameter values to member variables 
     this->title = title; //Set book title 
-    this->author = author; //Set book author 
+    this->authorId = authorId; //Set book author 
     this->isbn = isbn; //Set book ISBN
     this->publication_year = publication_year; //Set book's publication year 
     this->total_copies = total_copies; //Set total copies of book 
     this->available_copies = available_copies; //Set available copies of book
+    this->node = nullptr; //Book is not in any category yet
+    this->row = -1; //Book has no row in the book columns yet
+    this->titleDoc = -1; //Book is not in the title search index yet
+    this->authorSlot = -1; //Book is not in the author index yet
+    this->isbnKey = 0; //ISBN is normalized when the book is indexed
+    this->prevSameTitle = nullptr; //Book is not in the title index yet
+    this->nextSameTitle = nullptr;
+}
+
+//Function to return the name of the author from the author names of the catalog
+const std::string& Book::getAuthor(const StringPool& authorNames) const {
+    return authorNames.str(authorId);
+}
+
+//Function to change the author, interning the new name
+void Book::setAuthor(StringPool& authorNames, const std::string& author) {
+    authorId = authorNames.intern(author);
 }
 
 //Function to display details of book 
-void Book::display(){
+void Book::display(const StringPool& authorNames){
     //Display all the details of the book, including title, author, ISBN, publication year, total copies, and available copies. 
     cout << "Title: " << title << std::endl;
-    cout << "Author: " << author << std::endl;
+    cout << "Author: " << getAuthor(authorNames) << std::endl;
     cout << "ISBN: " << isbn << std::endl;
     cout << "Publication Year: " << publication_year << std::endl;
     cout << "Total copies: " << total_copies << std::endl;
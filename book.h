@@ -9,29 +9,46 @@
 #ifndef _BOOK_H
 #define _BOOK_H
 #include <string>
+#include <atomic>
 #include "myvector.h"
+#include "stringpool.h"
 
 class Borrower;
+class Node;
 
 class Book
 {
 	private:
 		std::string title;
-		std::string author;
+		unsigned int authorId;	//id of the author in the author names of the catalog that holds the book
 		std::string isbn;
 		int publication_year;
 		int total_copies;
-		int available_copies;
+		std::atomic<int> available_copies;	//changed by concurrent circulation desks without the catalog write lock
 		MyVector<Borrower*> currentBorrowers;  
     	MyVector<Borrower*> allBorrowers;     
+		Node* node;				//category node that holds the book
+		int row;				//row of the book in the book columns, -1 if it has none
+		int titleDoc;			//document id of the book in the title search index, -1 if it has none
+		int authorSlot;			//position of the book in the author index list of its author, -1 if it has none
+		unsigned long long isbnKey;	//ISBN normalized to ISBN-13 as a number, 0 if the ISBN is not valid
+		Book* prevSameTitle;	//previous book with the same title in the title index, nullptr if it is the first
+		Book* nextSameTitle;	//next book with the same title in the title index, nullptr if it is the last
 
 	public:
-		Book(std::string title, std::string author, std::string isbn, int publication_year,int total_copies, int available_copies);
-		void display(); // display details of a book (see output of command findbook)
+		Book(std::string title, std::string author, std::string isbn, int publication_year,int total_copies, int available_copies, StringPool& authorNames);	//author is interned in authorNames
+		Book(std::string title, unsigned int authorId, std::string isbn, int publication_year,int total_copies, int available_copies);	//author already interned
+		const std::string& getAuthor(const StringPool& authorNames) const;	//return the author's name
+		void setAuthor(StringPool& authorNames, const std::string& author);	//change the author's name
+		void display(const StringPool& authorNames); // display details of a book (see output of command findbook)
 		friend class Tree;
 		friend class Node;
 		friend class LCMS;
 		friend class Borrower;
+		friend class BookColumns;
+		friend class TitleSearchIndex;
+		friend class AuthorIndex;
+		friend class YearIndex;
 };
 
 #endif
\ No newline at end of file
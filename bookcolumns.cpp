@@ -0,0 +1,122 @@
+//============================================================================
+// Name         : bookcolumns.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Columnar (struct-of-arrays) copy of the book fields for scans
+//============================================================================
+#include <climits>
+#include "bookcolumns.h"
+#include "tree.h"
+
+//Function to append a row for a book
+void BookColumns::add(Book* book){
+    //Remember the row in the book so that it can be found again in O(1)
+    book->row = books.size();
+    years.push_back(book->publication_year);
+    totals.push_back(book->total_copies);
+    availables.push_back(book->available_copies);
+    categories.push_back(book->node->id);
+    books.push_back(book);
+}
+
+//Function to remove the row of a book
+void BookColumns::remove(Book* book){
+    int row = book->row;
+    //If the book has no row, then there is nothing to remove
+    if (row < 0){
+        return;
+    }
+    //Move the last row into the hole so the columns stay contiguous
+    int last = books.size() - 1;
+    if (row != last){
+        years[row] = years[last];
+        totals[row] = totals[last];
+        availables[row] = availables[last];
+        categories[row] = categories[last];
+        books[row] = books[last];
+        books[row]->row = row;
+    }
+    years.pop_back();
+    totals.pop_back();
+    availables.pop_back();
+    categories.pop_back();
+    books.pop_back();
+    book->row = -1;
+}
+
+//Function to copy the current fields of a book into its row
+void BookColumns::refresh(Book* book){
+    int row = book->row;
+    if (row < 0){
+        return;
+    }
+    years[row] = book->publication_year;
+    totals[row] = book->total_copies;
+    __atomic_store_n(&availables[row], book->available_copies.load(), __ATOMIC_RELAXED);
+    categories[row] = book->node->id;
+}
+
+//Function to copy the available copies of a book into its row while summaries may be reading the column
+void BookColumns::refreshCopies(Book* book){
+    int row = book->row;
+    if (row < 0){
+        return;
+    }
+    //A relaxed atomic store: a concurrent summary sees either the old or the new count of the row
+    __atomic_store_n(&availables[row], book->available_copies.load(), __ATOMIC_RELAXED);
+}
+
+//Function to remove every row
+void BookColumns::clear(){
+    //The books themselves are released by the catalog, so only forget their rows
+    for (int i = 0; i < books.size(); i++){
+        books[i]->row = -1;
+    }
+    years.clear();
+    totals.clear();
+    availables.clear();
+    categories.clear();
+    books.clear();
+}
+
+//Function to return the number of rows
+int BookColumns::size() const {
+    return books.size();
+}
+
+//Function to aggregate the rows of the selected categories within a range of years
+ColumnSummary BookColumns::summarize(const MyVector<unsigned char>& selected, int fromYear, int toYear) const {
+    ColumnSummary summary = {0, 0, 0, 0, INT_MAX, INT_MIN};
+    const int* year = years.begin();
+    const int* total = totals.begin();
+    const int* available = availables.begin();
+    const unsigned int* category = categories.begin();
+    const unsigned char* mark = selected.begin();
+    int n = books.size();
+
+    //Branch-free loop over the columns: every row is weighted by whether it matches (0 or 1),
+    //so the compiler can keep the loop free of unpredictable jumps and vectorize the sums
+    //(available copies are loaded atomically, since circulation desks update them during the scan)
+    int count = 0, unavailable = 0;
+    long long totalSum = 0, availableSum = 0;
+    int minYear = INT_MAX, maxYear = INT_MIN;
+    for (int i = 0; i < n; i++){
+        int keep = mark[category[i]] & (year[i] >= fromYear) & (year[i] <= toYear);
+        int copies = __atomic_load_n(&available[i], __ATOMIC_RELAXED);
+        count += keep;
+        totalSum += keep * total[i];
+        availableSum += keep * copies;
+        unavailable += keep & (copies <= 0);
+        minYear = (keep && year[i] < minYear) ? year[i] : minYear;
+        maxYear = (keep && year[i] > maxYear) ? year[i] : maxYear;
+    }
+    summary.books = count;
+    summary.totalCopies = totalSum;
+    summary.availableCopies = availableSum;
+    summary.unavailableBooks = unavailable;
+    summary.minYear = minYear;
+    summary.maxYear = maxYear;
+    return summary;
+}
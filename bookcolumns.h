@@ -0,0 +1,49 @@
+//============================================================================
+// Name         : bookcolumns.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : header file for bookcolumns.cpp
+//============================================================================
+#ifndef _BOOKCOLUMNS_H
+#define _BOOKCOLUMNS_H
+
+#include "myvector.h"
+#include "book.h"
+
+//Result of an aggregate scan over the book columns
+struct ColumnSummary
+{
+	int books;					//number of matching books
+	long long totalCopies;		//sum of their total copies
+	long long availableCopies;	//sum of their available copies
+	int unavailableBooks;		//matching books without any available copy
+	int minYear;				//earliest publication year (only meaningful if books > 0)
+	int maxYear;				//latest publication year (only meaningful if books > 0)
+};
+
+//Struct-of-arrays copy of the numeric fields of every book, one row per book,
+//so that scans over many books touch only the columns they need
+class BookColumns
+{
+	private:
+		MyVector<int> years;					//publication year of each row
+		MyVector<int> totals;					//total copies of each row
+		MyVector<int> availables;				//available copies of each row (stored and loaded atomically: circulation
+												//updates it under the catalog read lock while summaries scan it)
+		MyVector<unsigned int> categories;		//id of the category node of each row
+		MyVector<Book*> books;					//book of each row
+
+	public:
+		void add(Book* book);					//append a row for a book that is in a category
+		void remove(Book* book);				//remove the row of a book (the last row takes its place)
+		void refresh(Book* book);				//copy the fields and category of a book into its row again
+		void refreshCopies(Book* book);			//copy only the available copies of a book into its row (safe during summarize)
+		void clear();							//remove every row
+		int size() const;						//return number of rows
+		//aggregate the rows whose category is marked in selected (indexed by category id) and whose year is in [fromYear, toYear]
+		ColumnSummary summarize(const MyVector<unsigned char>& selected, int fromYear, int toYear) const;
+};
+
+#endif
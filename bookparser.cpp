@@ -0,0 +1,358 @@
+//============================================================================
+// Name         : bookparser.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Parser for catalog CSV files, splitting large files over several threads
+//============================================================================
+#include <climits>
+#include <cstring>
+#include <thread>
+#include <chrono>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include "bookparser.h"
+#include "trace.h"
+
+using namespace std;
+
+//Files smaller than this are parsed on the calling thread
+static const size_t MIN_BYTES_PER_THREAD = 1 << 20;
+//Size of the blocks of a TextArena
+static const size_t ARENA_BLOCK_SIZE = 64 * 1024;
+
+//Function to compare the characters of two fields
+bool FieldView::operator==(const FieldView& other) const {
+    return size == other.size && (size == 0 || memcmp(data, other.data, size) == 0);
+}
+
+//Constructor
+TextArena::TextArena() : current(nullptr), left(0) {
+}
+
+//Function to copy text into the arena
+const char* TextArena::store(const char* text, size_t size){
+    //If the last block is full, then start a new one (large texts get a block of their own size)
+    if (size > left){
+        size_t blockSize = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+        blocks.push_back(unique_ptr<char[]>(new char[blockSize]));
+        current = blocks.back().get();
+        left = blockSize;
+    }
+    char* stored = current;
+    memcpy(stored, text, size);
+    current += size;
+    left -= size;
+    return stored;
+}
+
+//Function to find the first byte in [p, end) equal to a, b or c (end if there is none)
+static inline const char* scanFor(const char* p, const char* end, char a, char b, char c){
+#if defined(__AVX2__)
+    //Compare 32 bytes at a time and take the first match from the bit mask
+    const __m256i wideA = _mm256_set1_epi8(a), wideB = _mm256_set1_epi8(b), wideC = _mm256_set1_epi8(c);
+    while (end - p >= 32){
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)p);
+        __m256i hits = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, wideA), _mm256_cmpeq_epi8(bytes, wideB)), _mm256_cmpeq_epi8(bytes, wideC));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(hits);
+        if (mask){
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+#endif
+#if defined(__SSE2__)
+    //Compare 16 bytes at a time and take the first match from the bit mask
+    const __m128i vecA = _mm_set1_epi8(a), vecB = _mm_set1_epi8(b), vecC = _mm_set1_epi8(c);
+    while (end - p >= 16){
+        __m128i bytes = _mm_loadu_si128((const __m128i*)p);
+        __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, vecA), _mm_cmpeq_epi8(bytes, vecB)), _mm_cmpeq_epi8(bytes, vecC));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(hits);
+        if (mask){
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+#endif
+    //Check the remaining bytes one at a time
+    for (; p < end; ++p){
+        if (*p == a || *p == b || *p == c){
+            return p;
+        }
+    }
+    return end;
+}
+
+//Function to count the quotes in a range of bytes
+static void countQuotes(const char* begin, const char* end, size_t* count){
+    size_t quotes = 0;
+    const char* p = begin;
+#if defined(__SSE2__)
+    //Count 16 bytes at a time with the population count of the match mask
+    const __m128i quote = _mm_set1_epi8('\"');
+    while (end - p >= 16){
+        __m128i bytes = _mm_loadu_si128((const __m128i*)p);
+        quotes += __builtin_popcount((unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote)));
+        p += 16;
+    }
+#endif
+    for (; p < end; ++p){
+        quotes += (*p == '\"');
+    }
+    *count = quotes;
+}
+
+//Function to convert a field to an integer the way std::stoi does (leading spaces, sign, digits, trailing text ignored)
+static bool parseInt(const FieldView& field, int& value){
+    const char* p = field.data;
+    const char* end = p + field.size;
+    //Skip leading white space
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r' || *p == '\f' || *p == '\v')){
+        ++p;
+    }
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')){
+        negative = (*p == '-');
+        ++p;
+    }
+    //Fail if there are no digits
+    if (p == end || *p < '0' || *p > '9'){
+        return false;
+    }
+    //Accumulate the digits, failing as soon as the value cannot fit in an int
+    long long result = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p){
+        result = result * 10 + (*p - '0');
+        if (result > (long long)INT_MAX + 1){
+            return false;
+        }
+    }
+    if (negative){
+        result = -result;
+    }
+    if (result > INT_MAX || result < INT_MIN){
+        return false;
+    }
+    value = (int)result;
+    return true;
+}
+
+//Function to find the end of the line that starts at begin
+const char* findLineEnd(const char* begin, const char* end){
+    bool insideQuotes = false;
+    const char* p = begin;
+    //Jump from quote to quote and stop at the first newline outside quotes
+    while ((p = scanFor(p, end, '\"', '\n', '\n')) < end){
+        if (*p == '\n' && !insideQuotes){
+            return p;
+        }
+        if (*p == '\"'){
+            insideQuotes = !insideQuotes;
+        }
+        ++p;
+    }
+    return end;
+}
+
+//Function to split the line at p into fields (only the first 7 are kept); returns the newline that ends it, or end
+static const char* splitLine(const char* p, const char* end, FieldView* fields, int& fieldCount, string& scratch, TextArena& arena){
+    fieldCount = 0;
+    while (true){
+        const char* start = p;
+        const char* stop = scanFor(p, end, ',', '\"', '\n');
+        FieldView field = {start, (size_t)(stop - start)};
+        p = stop;
+
+        //A field with quotes is unquoted into scratch: quotes toggle, "" inside quotes is a quote, separators inside quotes are text
+        if (p < end && *p == '\"'){
+            scratch.assign(start, p);
+            bool insideQuotes = false;
+            while (p < end){
+                if (*p == '\"'){
+                    if (insideQuotes && p + 1 < end && p[1] == '\"'){
+                        scratch += '\"';
+                        p += 2;
+                    } else {
+                        insideQuotes = !insideQuotes;
+                        ++p;
+                    }
+                } else if (!insideQuotes && (*p == ',' || *p == '\n')){
+                    break;
+                } else {
+                    const char* next = insideQuotes ? scanFor(p, end, '\"', '\"', '\"') : scanFor(p, end, ',', '\"', '\n');
+                    scratch.append(p, next);
+                    p = next;
+                }
+            }
+            //Keep the unquoted text only if the field is used
+            field.size = scratch.size();
+            if (fieldCount < 7 && field.size > 0){
+                field.data = arena.store(scratch.data(), scratch.size());
+            }
+        }
+
+        bool lineEnds = (p == end || *p == '\n');
+        //As before, an empty last field does not count
+        if (!(lineEnds && field.size == 0)){
+            if (fieldCount < 7){
+                fields[fieldCount] = field;
+            }
+            fieldCount++;
+        }
+        if (lineEnds){
+            return p;
+        }
+        ++p; //Skip the comma
+    }
+}
+
+//Function to turn the fields of a line into a record
+static ParseStatus toRecord(const FieldView* fields, int fieldCount, BookRecord& record){
+    //The line needs every field of a book
+    if (fieldCount < 7){
+        return PARSE_BAD_FORMAT;
+    }
+    //Convert the copies first and then the publication year
+    if (!parseInt(fields[5], record.totalCopies) || !parseInt(fields[6], record.availableCopies)){
+        return PARSE_BAD_COPIES;
+    }
+    if (!parseInt(fields[3], record.publicationYear)){
+        return PARSE_BAD_YEAR;
+    }
+    record.title = fields[0];
+    record.author = fields[1];
+    record.isbn = fields[2];
+    record.category = fields[4];
+    return PARSE_OK;
+}
+
+//Function to parse one catalog line into a record
+ParseStatus parseBookLine(const char* begin, const char* end, BookRecord& record, TextArena& arena){
+    FieldView fields[7];
+    int fieldCount = 0;
+    string scratch;
+    splitLine(begin, end, fields, fieldCount, scratch, arena);
+    return toRecord(fields, fieldCount, record);
+}
+
+//Function to parse all the lines in a chunk into a batch
+static void parseChunk(const char* begin, const char* end, ParseBatch* batch){
+    //The field array and scratch buffer are reused for every line of the chunk
+    FieldView fields[7];
+    int fieldCount = 0;
+    string scratch;
+    BookRecord record;
+    //Catalog lines are rarely shorter than 64 bytes
+    batch->records.reserve((end - begin) / 64 + 1);
+
+    //While tracing, time the tokenizing and the numeric conversion of the lines separately
+    TraceSpan span("import.parseChunk");
+    bool traced = TraceLog::enabled();
+    std::chrono::steady_clock::duration tokenizing(0), converting(0);
+    std::chrono::steady_clock::time_point t0, t1;
+    long long lines = 0;
+
+    const char* line = begin;
+    while (line < end){
+        if (traced) t0 = std::chrono::steady_clock::now();
+        const char* lineEnd = splitLine(line, end, fields, fieldCount, scratch, batch->unquoted);
+        if (traced) t1 = std::chrono::steady_clock::now();
+        ParseStatus status = toRecord(fields, fieldCount, record);
+        if (traced){
+            tokenizing += t1 - t0;
+            converting += std::chrono::steady_clock::now() - t1;
+            lines++;
+        }
+        if (status == PARSE_OK){
+            batch->records.push_back(record);
+        } else {
+            ParseError error = {status, string(line, lineEnd)};
+            batch->errors.push_back(error);
+        }
+        //Move past the newline to the next line
+        line = lineEnd + 1;
+    }
+    span.arg("bytes", (long long)(end - begin));
+    span.arg("lines", lines);
+    span.arg("tokenizeUs", (long long)std::chrono::duration_cast<std::chrono::microseconds>(tokenizing).count());
+    span.arg("convertUs", (long long)std::chrono::duration_cast<std::chrono::microseconds>(converting).count());
+}
+
+//Function to find the start of the first line after p, given whether p is inside a quoted field
+static const char* nextLineStart(const char* p, const char* end, bool insideQuotes){
+    while ((p = scanFor(p, end, '\"', '\n', '\n')) < end){
+        if (*p == '\n' && !insideQuotes){
+            return p + 1;
+        }
+        if (*p == '\"'){
+            insideQuotes = !insideQuotes;
+        }
+        ++p;
+    }
+    return end;
+}
+
+//Function to parse a whole catalog, using several threads for large files
+void parseCatalog(const char* begin, const char* end, int maxThreads, vector<ParseBatch>& batches){
+    size_t size = end - begin;
+    int threads = (int)(size / MIN_BYTES_PER_THREAD);
+    if (threads > maxThreads) threads = maxThreads;
+    if (threads < 1) threads = 1;
+
+    batches.clear();
+    batches.resize(threads);
+    //A small file is parsed on the calling thread
+    if (threads == 1){
+        parseChunk(begin, end, &batches[0]);
+        return;
+    }
+
+    //Cut the file into equal raw ranges and count the quotes of each range in parallel
+    vector<const char*> cuts(threads + 1);
+    for (int i = 0; i <= threads; i++){
+        cuts[i] = begin + size * i / threads;
+    }
+    TraceSpan split("import.splitChunks");
+    vector<size_t> quotes(threads);
+    vector<thread> workers;
+    for (int i = 0; i < threads; i++){
+        workers.push_back(thread(countQuotes, cuts[i], cuts[i + 1], &quotes[i]));
+    }
+    for (int i = 0; i < threads; i++){
+        workers[i].join();
+    }
+    workers.clear();
+
+    //Move every cut forward to the start of the next line; the quotes before the cut tell if it falls inside a quoted field
+    vector<const char*> starts(threads + 1);
+    starts[0] = begin;
+    starts[threads] = end;
+    size_t quotesBefore = 0;
+    for (int i = 1; i < threads; i++){
+        quotesBefore += quotes[i - 1];
+        bool insideQuotes = (quotesBefore % 2) == 1;
+        const char* p = cuts[i];
+        //A cut right after a newline is already the start of a line
+        if (!(p[-1] == '\n' && !insideQuotes)){
+            p = nextLineStart(p, end, insideQuotes);
+        }
+        //A very long line may swallow a whole range, so starts never go backwards
+        starts[i] = p < starts[i - 1] ? starts[i - 1] : p;
+    }
+
+    split.arg("threads", threads);
+    split.end();
+
+    //Parse the chunks in parallel, each into its own batch
+    for (int i = 0; i < threads; i++){
+        workers.push_back(thread(parseChunk, starts[i], starts[i + 1], &batches[i]));
+    }
+    for (int i = 0; i < threads; i++){
+        workers[i].join();
+    }
+}
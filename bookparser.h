@@ -0,0 +1,86 @@
+//============================================================================
+// Name         : bookparser.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : header file for bookparser.cpp
+//============================================================================
+#ifndef _BOOKPARSER_H
+#define _BOOKPARSER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+//Read-only view of the characters of a field (they live in the mapped file or in a batch's TextArena)
+struct FieldView
+{
+	const char* data;
+	std::size_t size;
+
+	std::string str() const { return std::string(data, size); }
+	bool operator==(const FieldView& other) const;
+};
+
+//Fields of one catalog line (Title,Author,ISBN,Publication Year,Category,Total Copies,Available Copies)
+struct BookRecord
+{
+	FieldView title;
+	FieldView author;
+	FieldView isbn;
+	FieldView category;
+	int publicationYear;
+	int totalCopies;
+	int availableCopies;
+};
+
+//Outcome of parsing one catalog line
+enum ParseStatus
+{
+	PARSE_OK,
+	PARSE_BAD_FORMAT,		//fewer than 7 fields
+	PARSE_BAD_COPIES,		//total or available copies is not a number
+	PARSE_BAD_YEAR			//publication year is not a number
+};
+
+//A line that could not be parsed
+struct ParseError
+{
+	ParseStatus status;
+	std::string line;
+};
+
+//Append-only storage for the text of quoted fields; stored text never moves
+class TextArena
+{
+	private:
+		std::vector<std::unique_ptr<char[]> > blocks;
+		char* current;			//next free byte of the last block
+		std::size_t left;		//free bytes in the last block
+
+	public:
+		TextArena();
+		const char* store(const char* text, std::size_t size);	//copy text into the arena and return where it lives
+};
+
+//Books and errors of one chunk of the catalog, both in file order
+struct ParseBatch
+{
+	std::vector<BookRecord> records;
+	std::vector<ParseError> errors;
+	TextArena unquoted;		//text of the fields that contained quotes
+};
+
+//Return the end of the line starting at begin (the newline or end); newlines inside quotes do not end a line
+const char* findLineEnd(const char* begin, const char* end);
+
+//Parse one catalog line (without its newline) into record; quoted field text is kept in arena
+ParseStatus parseBookLine(const char* begin, const char* end, BookRecord& record, TextArena& arena);
+
+//Parse every line in [begin, end) on up to maxThreads threads; batches receives one batch per chunk in file order.
+//The records point into [begin, end), which must stay valid while they are used.
+void parseCatalog(const char* begin, const char* end, int maxThreads, std::vector<ParseBatch>& batches);
+
+#endif
@@ -16,12 +16,12 @@ Borrower::Borrower(const std::string name, std::string id){
 }
 
 //Function to display all the books borrowed by a certain borrower
-void Borrower::listBooks(){
+void Borrower::listBooks(const StringPool& authorNames){
     //Display the borrower's name and ID 
     std::cout << "Books borrowed by " << name << "(" << id << ")" << std::endl;
     //Loop through the list of the books that are borrowed by the borrower 
     for (int i = 0; i < books_borrowed.size(); i++){
         std::cout << i + 1 << ": "; //Display the position of the books in the list 
-        books_borrowed[i]->display(); //Call display function of the Book object to show the details of the book
+        books_borrowed[i]->display(authorNames); //Call display function of the Book object to show the details of the book
     }
 }
@@ -21,7 +21,7 @@ class Borrower {
 		MyVector<Book*> books_borrowed;  
 	public:
 		Borrower(const std::string name, std::string id);
-		void listBooks();
+		void listBooks(const StringPool& authorNames);	//author names of the catalog that holds the books
 		friend class LCMS;
 		friend class Tree;
 		friend class Book;
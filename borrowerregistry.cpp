@@ -0,0 +1,76 @@
+//============================================================================
+// Name         : borrowerregistry.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Registry that owns the borrowers and finds them by (name, id) or id
+//============================================================================
+#include <functional>
+#include "borrowerregistry.h"
+
+//Function to hash a (name, id) pair
+std::size_t BorrowerKeyHash::operator()(const BorrowerKey& key) const {
+    //Combine the hashes of name and id so that swapped values do not collide
+    std::size_t h = std::hash<std::string>()(key.name);
+    return h ^ (std::hash<std::string>()(key.id) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+}
+
+//Constructor
+BorrowerRegistry::BorrowerRegistry(){
+}
+
+//Deconstructor
+BorrowerRegistry::~BorrowerRegistry(){
+    clear();
+}
+
+//Function to delete every registered borrower
+void BorrowerRegistry::clear(){
+    //Deallocate every registered borrower at once
+    pool.releaseAll();
+    borrowers.clear();
+    byNameId.clear();
+    byId.clear();
+}
+
+//Function to find the borrower with the given name and id
+Borrower* BorrowerRegistry::find(const std::string& name, const std::string& id){
+    std::lock_guard<std::mutex> guard(lock);
+    BorrowerKey key = {name, id};
+    Borrower** borrower = byNameId.find(key);
+    return borrower ? *borrower : nullptr;
+}
+
+//Function to find a borrower with the given id
+Borrower* BorrowerRegistry::findById(const std::string& id){
+    std::lock_guard<std::mutex> guard(lock);
+    Borrower** borrower = byId.find(id);
+    return borrower ? *borrower : nullptr;
+}
+
+//Function to find the borrower with the given name and id, creating a new one if it does not exist
+Borrower* BorrowerRegistry::findOrCreate(const std::string& name, const std::string& id){
+    std::lock_guard<std::mutex> guard(lock);
+    BorrowerKey key = {name, id};
+    Borrower** found = byNameId.find(key);
+    if (found){
+        return *found;
+    }
+    //Create a new borrower and register it in both indexes
+    Borrower* borrower = pool.create(name, id);
+    borrowers.push_back(borrower);
+    byNameId.insert(key, borrower);
+    byId.insert(id, borrower);
+    return borrower;
+}
+
+//Function to return the number of registered borrowers
+int BorrowerRegistry::size() const {
+    return borrowers.size();
+}
+
+//Overload function to access the registered borrowers in registration order
+Borrower* BorrowerRegistry::operator[](int index){
+    return borrowers[index];
+}
@@ -0,0 +1,58 @@
+//============================================================================
+// Name         : borrowerregistry.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : header file for borrowerregistry.cpp
+//============================================================================
+#ifndef _BORROWERREGISTRY_H
+#define _BORROWERREGISTRY_H
+
+#include <string>
+#include <mutex>
+#include "myvector.h"
+#include "myhashmap.h"
+#include "objectpool.h"
+#include "borrower.h"
+
+//Key of the registry: a borrower is identified by both name and id
+struct BorrowerKey
+{
+	std::string name;
+	std::string id;
+	bool operator==(const BorrowerKey& other) const { return name == other.name && id == other.id; }
+};
+
+//Hash function object for BorrowerKey
+struct BorrowerKeyHash
+{
+	std::size_t operator()(const BorrowerKey& key) const;
+};
+
+class BorrowerRegistry
+{
+	private:
+		ObjectPool<Borrower> pool;									//storage of every registered borrower
+		MyVector<Borrower*> borrowers;								//every borrower in registration order
+		MyHashMap<BorrowerKey, Borrower*, BorrowerKeyHash> byNameId;	//(name, id) -> borrower
+		MyHashMap<std::string, Borrower*> byId;					//id -> first borrower registered with that id
+		std::mutex lock;										//serializes find/findById/findOrCreate between circulation desks
+
+		BorrowerRegistry(const BorrowerRegistry&);				//the registry owns its borrowers, so it cannot be copied
+		BorrowerRegistry& operator=(const BorrowerRegistry&);
+
+	public:
+		BorrowerRegistry();
+		~BorrowerRegistry();									//deletes every registered borrower
+
+		Borrower* find(const std::string& name, const std::string& id);	//return the borrower with name and id, nullptr if not registered
+		Borrower* findById(const std::string& id);				//return a borrower with the given id, nullptr if not registered
+		Borrower* findOrCreate(const std::string& name, const std::string& id);	//return the borrower with name and id, registering it if needed
+		//(size, clear and operator[] are not locked; the catalog only uses them while no desk is lending)
+		int size() const;										//return number of registered borrowers
+		void clear();											//delete every registered borrower
+		Borrower* operator[](int index);						//return the index-th registered borrower
+};
+
+#endif
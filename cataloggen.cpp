@@ -0,0 +1,130 @@
+//============================================================================
+// Name         : cataloggen.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Synthetic catalog generator for benchmarks
+//============================================================================
+#include <string>
+#include <iostream>
+#include "cataloggen.h"
+#include "csvwriter.h"
+
+using namespace std;
+
+//Words mixed into the titles and authors so that they are not all alike
+static const char* const WORDS[] = {"River", "Winter", "Glass", "Empire", "Garden", "Signal", "Harbor", "Letters",
+                                    "Shadow", "Machine", "Orchard", "Silence", "Atlas", "Ember", "Northern", "Voyage"};
+static const int WORD_COUNT = sizeof(WORDS) / sizeof(WORDS[0]);
+
+//Constructor to build the category paths of the shape
+CatalogGenerator::CatalogGenerator(const CatalogShape& shape) : shape(shape), state(shape.seed) {
+    //Keep at least one level with one category
+    if (this->shape.depth < 1) this->shape.depth = 1;
+    if (this->shape.fanout < 1) this->shape.fanout = 1;
+
+    //Reduce the depth until the whole tree fits in MAX_CATEGORIES
+    long long total;
+    do {
+        total = 0;
+        long long level = 1;
+        for (int d = 0; d < this->shape.depth; d++) {
+            level *= this->shape.fanout;
+            total += level;
+        }
+        if (total > MAX_CATEGORIES) {
+            cerr << "Warning: " << total << " categories are too many, the depth is reduced to " << this->shape.depth - 1 << endl;
+            this->shape.depth--;
+        }
+    } while (total > MAX_CATEGORIES && this->shape.depth > 1);
+
+    //Build the paths level by level, so every parent comes before its children
+    categories.reserve((int)total);
+    int levelStart = 0;
+    for (int i = 0; i < this->shape.fanout; i++) {
+        categories.push_back("Category" + to_string(i));
+    }
+    for (int d = 1; d < this->shape.depth; d++) {
+        int levelEnd = categories.size();
+        for (int parent = levelStart; parent < levelEnd; parent++) {
+            for (int i = 0; i < this->shape.fanout; i++) {
+                categories.push_back(categories[parent] + "/Sub" + to_string(d) + "_" + to_string(i));
+            }
+        }
+        levelStart = levelEnd;
+    }
+    firstLeaf = levelStart;
+}
+
+//Function to return the next pseudo-random number (splitmix64, the same on every platform)
+unsigned long long CatalogGenerator::next() {
+    unsigned long long z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+//Function to return a pseudo-random number in [0, bound)
+int CatalogGenerator::nextInt(int bound) {
+    return bound <= 0 ? 0 : (int)(next() % (unsigned long long)bound);
+}
+
+//Function to restart the random numbers from the seed
+void CatalogGenerator::reseed() {
+    state = shape.seed;
+}
+
+//Function to return the title of a book
+string CatalogGenerator::title(int book) const {
+    return string(WORDS[book % WORD_COUNT]) + " " + WORDS[(book / WORD_COUNT) % WORD_COUNT] + " " + to_string(book);
+}
+
+//Function to return the ISBN-13 of a book: prefix 978, the book number as 9 digits, and the check digit
+string CatalogGenerator::isbn(int book) const {
+    string digits = "978" + string(9 - to_string(book % 1000000000).size(), '0') + to_string(book % 1000000000);
+    int sum = 0;
+    for (int i = 0; i < 12; i++) {
+        sum += (digits[i] - '0') * (i % 2 == 0 ? 1 : 3);
+    }
+    return digits + (char)('0' + (10 - sum % 10) % 10);
+}
+
+//Function to write every book to a CSV file in the format read by import
+bool CatalogGenerator::writeCsv(const string& path) {
+    CsvWriter writer;
+    if (!writer.open(path)) {
+        cerr << "We can't open the file, which is " << path << endl;
+        return false;
+    }
+    reseed();
+    writer.writeRaw("Title,Author,ISBN,Publication Year,Category,Total Copies,Available Copies\n");
+    int leaves = categories.size() - firstLeaf;
+    for (int book = 0; book < shape.books; book++) {
+        int copies = 1 + nextInt(8);
+        writer.writeField(title(book));
+        writer.writeField(string("Author ") + WORDS[nextInt(WORD_COUNT)] + " " + to_string(nextInt(shape.books / 4 + 1)));
+        writer.writeField(isbn(book));
+        writer.writeInt(1900 + nextInt(126));
+        writer.writeField(categories[firstLeaf + nextInt(leaves)]);
+        writer.writeInt(copies);
+        writer.writeInt(copies);
+        writer.endRecord();
+    }
+    return writer.close();
+}
+
+//Function to return every category path
+const MyVector<string>& CatalogGenerator::categoryPaths() const {
+    return categories;
+}
+
+//Function to return the number of categories right below the root
+int CatalogGenerator::topLevelCategories() const {
+    return shape.fanout;
+}
+
+//Function to return the shape (after any reduction of the depth)
+const CatalogShape& CatalogGenerator::getShape() const {
+    return shape;
+}
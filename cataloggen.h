@@ -0,0 +1,50 @@
+//============================================================================
+// Name         : cataloggen.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : header file for cataloggen.cpp
+//============================================================================
+#ifndef _CATALOGGEN_H
+#define _CATALOGGEN_H
+
+#include <string>
+#include "myvector.h"
+
+//Shape of a synthetic catalog
+struct CatalogShape
+{
+	int books;					//number of books
+	int depth;					//levels of categories below the root
+	int fanout;					//sub-categories of every category that is not a leaf
+	unsigned long long seed;	//the same shape and seed always give the same catalog
+};
+
+//Generates catalogs of a given shape in the CSV format read by import, deterministically from a seed
+class CatalogGenerator
+{
+	private:
+		CatalogShape shape;
+		unsigned long long state;			//state of the random number generator (splitmix64)
+		MyVector<std::string> categories;	//every category path, each parent before its children
+		int firstLeaf;						//categories[firstLeaf..] are the deepest categories, which hold the books
+
+	public:
+		static const int MAX_CATEGORIES = 2000000;	//depth and fanout are reduced until the tree fits
+
+		CatalogGenerator(const CatalogShape& shape);
+
+		unsigned long long next();			//Return the next pseudo-random number
+		int nextInt(int bound);				//Return a pseudo-random number in [0, bound)
+		void reseed();						//Restart the random numbers from the seed
+
+		bool writeCsv(const std::string& path);	//write every book to a CSV file, return false if it cannot be written
+		std::string title(int book) const;		//title of the book-th book (unique)
+		std::string isbn(int book) const;		//valid ISBN-13 of the book-th book (unique)
+		const MyVector<std::string>& categoryPaths() const;	//every category path, each parent before its children
+		int topLevelCategories() const;			//number of categories right below the root (the first ones of categoryPaths)
+		const CatalogShape& getShape() const;
+};
+
+#endif
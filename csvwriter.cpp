@@ -0,0 +1,151 @@
+//============================================================================
+// Name         : csvwriter.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Buffered CSV writer used to export the catalog
+//============================================================================
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include "csvwriter.h"
+
+//Constructor
+CsvWriter::CsvWriter(std::size_t bufferSize) : fd(-1), used(0), bufferSize(bufferSize), failed(false), firstField(true) {
+    buffer = new char[bufferSize];
+}
+
+//Deconstructor
+CsvWriter::~CsvWriter(){
+    close();
+    delete[] buffer;
+}
+
+//Function to create the output file
+bool CsvWriter::open(const std::string& path){
+    close();
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    failed = false;
+    firstField = true;
+    return fd >= 0;
+}
+
+//Function to copy bytes into the buffer
+void CsvWriter::append(const char* text, std::size_t size){
+    //Flush when the bytes do not fit, and write very large texts straight through
+    if (used + size > bufferSize){
+        flush();
+        if (size > bufferSize){
+            writeAll(text, size);
+            return;
+        }
+    }
+    memcpy(buffer + used, text, size);
+    used += size;
+}
+
+//Function to write the comma that separates fields
+void CsvWriter::separate(){
+    if (!firstField){
+        if (used == bufferSize) flush();
+        buffer[used++] = ',';
+    }
+    firstField = false;
+}
+
+//Function to write text as it is
+void CsvWriter::writeRaw(const std::string& text){
+    append(text.data(), text.size());
+}
+
+//Function to write one field
+void CsvWriter::writeField(const std::string& field){
+    writeField(field.data(), field.size());
+}
+
+//Function to write a field given by its characters, quoting it if needed
+void CsvWriter::writeField(const char* field, std::size_t size){
+    separate();
+    //Fields without special characters are copied as they are
+    std::size_t i = 0;
+    while (i < size && field[i] != ',' && field[i] != '\"' && field[i] != '\n' && field[i] != '\r'){
+        i++;
+    }
+    if (i == size){
+        append(field, size);
+        return;
+    }
+    //Other fields are quoted, with every quote doubled so that import reads them back unchanged
+    append("\"", 1);
+    std::size_t start = 0;
+    for (std::size_t quote = 0; quote < size; quote++){
+        if (field[quote] == '\"'){
+            append(field + start, quote - start + 1);
+            append("\"", 1);
+            start = quote + 1;
+        }
+    }
+    append(field + start, size - start);
+    append("\"", 1);
+}
+
+//Function to write an integer field without going through a stream
+void CsvWriter::writeInt(int value){
+    separate();
+    char digits[12];
+    char* p = digits + sizeof(digits);
+    //Work with the magnitude as unsigned so that the smallest int does not overflow
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    do {
+        *--p = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0){
+        *--p = '-';
+    }
+    append(p, digits + sizeof(digits) - p);
+}
+
+//Function to end the current record
+void CsvWriter::endRecord(){
+    if (used == bufferSize) flush();
+    buffer[used++] = '\n';
+    firstField = true;
+}
+
+//Function to write the buffered bytes to the file
+bool CsvWriter::flush(){
+    writeAll(buffer, used);
+    used = 0;
+    return !failed;
+}
+
+//Function to hand bytes to the kernel
+void CsvWriter::writeAll(const char* p, std::size_t left){
+    //A write may be partial or interrupted, so keep writing until every byte is written
+    while (left > 0 && fd >= 0 && !failed){
+        ssize_t written = ::write(fd, p, left);
+        if (written < 0){
+            if (errno == EINTR) continue;
+            failed = true;
+            break;
+        }
+        p += written;
+        left -= (std::size_t)written;
+    }
+}
+
+//Function to flush and close the file
+bool CsvWriter::close(){
+    if (fd < 0){
+        return !failed;
+    }
+    flush();
+    if (::close(fd) != 0){
+        failed = true;
+    }
+    fd = -1;
+    return !failed;
+}
@@ -0,0 +1,47 @@
+//============================================================================
+// Name         : csvwriter.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : header file for csvwriter.cpp
+//============================================================================
+#ifndef _CSVWRITER_H
+#define _CSVWRITER_H
+
+#include <string>
+#include <cstddef>
+
+//Writes CSV records into a large buffer that is handed to the kernel in big blocks
+class CsvWriter
+{
+	private:
+		int fd;					//file descriptor of the output file, -1 if not open
+		char* buffer;			//records waiting to be written
+		std::size_t used;		//bytes of buffer in use
+		std::size_t bufferSize;	//capacity of buffer
+		bool failed;			//true once a write has failed
+		bool firstField;		//true if the next field starts a record
+
+		CsvWriter(const CsvWriter&);				//a writer cannot be copied
+		CsvWriter& operator=(const CsvWriter&);
+
+		void append(const char* text, std::size_t size);	//copy bytes into the buffer, flushing when it is full
+		void separate();								//write the comma before every field but the first
+		void writeAll(const char* text, std::size_t size);	//write bytes to the file, retrying partial writes
+
+	public:
+		CsvWriter(std::size_t bufferSize = 1 << 20);
+		~CsvWriter();			//flushes and closes the file
+
+		bool open(const std::string& path);			//create or truncate the file, return false if it cannot be opened
+		void writeRaw(const std::string& text);		//write text as it is (e.g. a header line)
+		void writeField(const std::string& field);	//write a field, quoting it if it contains a comma, quote or newline
+		void writeField(const char* field, std::size_t size);	//write a field given by its characters
+		void writeInt(int value);					//write an integer field
+		void endRecord();							//end the current record with a newline
+		bool flush();								//write the buffered bytes, return false if a write failed
+		bool close();								//flush and close the file, return false if a write failed
+};
+
+#endif
@@ -0,0 +1,77 @@
+//============================================================================
+// Name         : isbn.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Validation and normalization of ISBNs to 64-bit keys
+//============================================================================
+#include "isbn.h"
+
+//Function to normalize an ISBN-10 or ISBN-13 to the number of its ISBN-13
+bool normalizeIsbn(const char* data, std::size_t size, unsigned long long& key){
+    //Collect the digits, skipping the separators; 'X' (value 10) may only be the check digit of an ISBN-10
+    int digits[13];
+    int count = 0;
+    bool hasX = false;
+    for (std::size_t i = 0; i < size; i++){
+        char c = data[i];
+        if (c == '-' || c == ' '){
+            continue;
+        }
+        if (hasX || count == 13){
+            return false;
+        }
+        if (c >= '0' && c <= '9'){
+            digits[count++] = c - '0';
+        } else if ((c == 'X' || c == 'x') && count == 9){
+            digits[count++] = 10;
+            hasX = true;
+        } else {
+            return false;
+        }
+    }
+
+    if (count == 10){
+        //ISBN-10: the digits weighted 10 down to 1 must sum to a multiple of 11
+        int sum = 0;
+        for (int i = 0; i < 10; i++){
+            sum += (10 - i) * digits[i];
+        }
+        if (sum % 11 != 0){
+            return false;
+        }
+        //Convert to ISBN-13: prefix 978, keep the first nine digits and compute the new check digit
+        int isbn13[13] = {9, 7, 8};
+        for (int i = 0; i < 9; i++){
+            isbn13[3 + i] = digits[i];
+        }
+        int weighted = 0;
+        for (int i = 0; i < 12; i++){
+            weighted += isbn13[i] * (i % 2 ? 3 : 1);
+        }
+        isbn13[12] = (10 - weighted % 10) % 10;
+        key = 0;
+        for (int i = 0; i < 13; i++){
+            key = key * 10 + isbn13[i];
+        }
+        return true;
+    }
+
+    if (count == 13 && !hasX){
+        //ISBN-13: the digits weighted 1,3,1,3,... must sum to a multiple of 10
+        int weighted = 0;
+        key = 0;
+        for (int i = 0; i < 13; i++){
+            weighted += digits[i] * (i % 2 ? 3 : 1);
+            key = key * 10 + digits[i];
+        }
+        return weighted % 10 == 0;
+    }
+    return false;
+}
+
+//Function to normalize an ISBN held in a string
+bool normalizeIsbn(const std::string& isbn, unsigned long long& key){
+    return normalizeIsbn(isbn.data(), isbn.size(), key);
+}
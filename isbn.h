@@ -0,0 +1,20 @@
+//============================================================================
+// Name         : isbn.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : header file for isbn.cpp
+//============================================================================
+#ifndef _ISBN_H
+#define _ISBN_H
+
+#include <string>
+#include <cstddef>
+
+//Convert an ISBN-10 or ISBN-13 (hyphens and spaces allowed) to its ISBN-13 as a number.
+//Return false if the ISBN is malformed or its check digit is wrong.
+bool normalizeIsbn(const char* data, std::size_t size, unsigned long long& key);
+bool normalizeIsbn(const std::string& isbn, unsigned long long& key);
+
+#endif
@@ -0,0 +1,233 @@
+//============================================================================
+// Name         : journal.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Write-ahead journal of catalog changes with group commit
+//============================================================================
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "journal.h"
+#include "mappedfile.h"
+
+//Each record is stored as: payload length (4 bytes), checksum of the payload (4 bytes), payload.
+//The payload is the operation (1 byte), the number of arguments (1 byte) and every argument as length (4 bytes) and bytes.
+static const std::size_t RECORD_HEADER_SIZE = 8;
+
+//Function to compute the FNV-1a checksum of a payload
+static uint32_t checksum(const char* data, std::size_t size){
+    uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; i++){
+        hash ^= (unsigned char)data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+//Function to append a 32-bit integer to a buffer
+static void putUint32(std::string& out, uint32_t value){
+    out.append((const char*)&value, sizeof(value));
+}
+
+//Function to read a 32-bit integer from a buffer
+static uint32_t getUint32(const char* p){
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+//Function to decode the payload of a record, return false if it is malformed
+static bool decode(const char* p, std::size_t size, JournalRecord& record){
+    const char* end = p + size;
+    if (size < 2){
+        return false;
+    }
+    record.op = (JournalOp)(unsigned char)p[0];
+    int count = (unsigned char)p[1];
+    p += 2;
+    record.args.clear();
+    for (int i = 0; i < count; i++){
+        if (end - p < 4){
+            return false;
+        }
+        uint32_t length = getUint32(p);
+        p += 4;
+        if ((std::size_t)(end - p) < length){
+            return false;
+        }
+        record.args.push_back(std::string(p, length));
+        p += length;
+    }
+    return p == end;
+}
+
+//Constructor
+Journal::Journal() : fd(-1), appendedSeq(0), durableSeq(0), failed(false), writing(false), stopping(false) {
+}
+
+//Deconstructor
+Journal::~Journal(){
+    close();
+}
+
+//Function to open a journal and read the records it already holds
+bool Journal::open(const std::string& path, std::vector<JournalRecord>& records){
+    close();
+    records.clear();
+
+    //Read every complete record; a torn or corrupt record ends the valid part of the journal
+    std::size_t validSize = 0;
+    {
+        MappedFile existing;
+        if (existing.open(path)){
+            const char* data = existing.data();
+            std::size_t size = existing.size();
+            JournalRecord record;
+            while (size - validSize >= RECORD_HEADER_SIZE){
+                const char* p = data + validSize;
+                uint32_t length = getUint32(p);
+                if (size - validSize - RECORD_HEADER_SIZE < length || getUint32(p + 4) != checksum(p + RECORD_HEADER_SIZE, length)
+                    || !decode(p + RECORD_HEADER_SIZE, length, record)){
+                    break;
+                }
+                records.push_back(record);
+                validSize += RECORD_HEADER_SIZE + length;
+            }
+        }
+    }
+
+    //Open the journal for appending and cut off anything after the last valid record
+    int file = ::open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (file < 0){
+        return false;
+    }
+    if (ftruncate(file, (off_t)validSize) != 0 || lseek(file, 0, SEEK_END) < 0){
+        ::close(file);
+        return false;
+    }
+    {
+        //Publish the file under the lock, together with the state the waiters look at
+        std::unique_lock<std::mutex> guard(lock);
+        appendedSeq = 0;
+        durableSeq = 0;
+        failed = false;
+        writing = false;
+        stopping = false;
+        fd = file;
+    }
+    flusher = std::thread(&Journal::flushLoop, this);
+    return true;
+}
+
+//Function to check if the journal is open
+bool Journal::isOpen() const {
+    return fd >= 0;
+}
+
+//Function to queue a record to be written by the next group commit
+uint64_t Journal::append(const JournalRecord& record){
+    //Encode the payload
+    std::string payload;
+    payload += (char)record.op;
+    payload += (char)record.args.size();
+    for (std::size_t i = 0; i < record.args.size(); i++){
+        putUint32(payload, (uint32_t)record.args[i].size());
+        payload += record.args[i];
+    }
+
+    std::unique_lock<std::mutex> guard(lock);
+    putUint32(pending, (uint32_t)payload.size());
+    putUint32(pending, checksum(payload.data(), payload.size()));
+    pending += payload;
+    uint64_t seq = ++appendedSeq;
+    wakeFlusher.notify_one();
+    return seq;
+}
+
+//Function to wait until a record is on disk
+bool Journal::waitDurable(uint64_t seq){
+    std::unique_lock<std::mutex> guard(lock);
+    while (durableSeq < seq && !failed && fd >= 0){
+        durable.wait(guard);
+    }
+    return !failed && durableSeq >= seq;
+}
+
+//Body of the flusher thread: write and fsync everything appended so far, one group at a time
+void Journal::flushLoop(){
+    std::unique_lock<std::mutex> guard(lock);
+    while (true){
+        while (pending.empty() && !stopping){
+            wakeFlusher.wait(guard);
+        }
+        if (pending.empty() && stopping){
+            break;
+        }
+        //Take the whole group; records appended while it is being written go into the next group
+        std::string group;
+        group.swap(pending);
+        uint64_t groupSeq = appendedSeq;
+        writing = true;
+        guard.unlock();
+        bool ok = writeAll(group.data(), group.size()) && fdatasync(fd) == 0;
+        guard.lock();
+        writing = false;
+        if (ok){
+            durableSeq = groupSeq;
+        } else {
+            failed = true;
+        }
+        durable.notify_all();
+    }
+}
+
+//Function to write bytes to the journal
+bool Journal::writeAll(const char* data, std::size_t size){
+    while (size > 0){
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0){
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= (std::size_t)written;
+    }
+    return true;
+}
+
+//Function to empty the journal once its changes are in a snapshot
+bool Journal::truncate(){
+    if (fd < 0){
+        return false;
+    }
+    //Wait until every appended record is written; holding the lock keeps the flusher from starting another group
+    std::unique_lock<std::mutex> guard(lock);
+    while ((!pending.empty() || writing) && !failed){
+        durable.wait(guard);
+    }
+    return !failed && ftruncate(fd, 0) == 0 && lseek(fd, 0, SEEK_SET) == 0 && fsync(fd) == 0;
+}
+
+//Function to commit the pending records and close the journal
+void Journal::close(){
+    if (fd < 0){
+        return;
+    }
+    //Let the flusher write the last group and stop
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        stopping = true;
+        wakeFlusher.notify_one();
+    }
+    flusher.join();
+    //Close the file under the lock, so a waiter either sees the journal open and gets the notification,
+    //or sees it closed before it starts waiting
+    std::unique_lock<std::mutex> guard(lock);
+    ::close(fd);
+    fd = -1;
+    durable.notify_all();
+}
@@ -0,0 +1,75 @@
+//============================================================================
+// Name         : journal.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : header file for journal.cpp
+//============================================================================
+#ifndef _JOURNAL_H
+#define _JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+
+//Operations recorded in the journal; the arguments of each are listed next to it
+enum JournalOp
+{
+	JOURNAL_ADD_BOOK = 1,		//title, author, isbn, publication year, total copies, available copies, category
+	JOURNAL_EDIT_BOOK,			//title, field number of the edit menu (1-6), new value
+	JOURNAL_REMOVE_BOOK,		//title
+	JOURNAL_BORROW_BOOK,		//title, borrower name, borrower id
+	JOURNAL_RETURN_BOOK,		//title, borrower name, borrower id
+	JOURNAL_ADD_CATEGORY,		//category path
+	JOURNAL_REMOVE_CATEGORY,	//category path
+	JOURNAL_EDIT_CATEGORY		//category path, new category path
+};
+
+//One journal entry
+struct JournalRecord
+{
+	JournalOp op;
+	std::vector<std::string> args;
+};
+
+//Append-only log of catalog changes. Records are appended to memory and a background thread writes
+//and fsyncs everything appended so far in one go (group commit), so concurrent writers share fsyncs.
+class Journal
+{
+	private:
+		std::atomic<int> fd;				//file descriptor of the journal, -1 if closed (changed under lock, isOpen reads it without)
+		std::string pending;				//encoded records not written yet
+		uint64_t appendedSeq;				//number of records appended
+		uint64_t durableSeq;				//number of records written and fsynced
+		bool failed;						//true once a write or fsync failed
+		bool writing;						//true while the flusher writes a group outside the lock
+		bool stopping;						//tells the flusher thread to finish
+		std::mutex lock;
+		std::condition_variable wakeFlusher;	//signalled when records are appended or on close
+		std::condition_variable durable;		//signalled when a group has been fsynced
+		std::thread flusher;
+
+		Journal(const Journal&);				//a journal cannot be copied
+		Journal& operator=(const Journal&);
+
+		void flushLoop();					//body of the flusher thread
+		bool writeAll(const char* data, std::size_t size);	//write bytes to the file, retrying partial writes
+
+	public:
+		Journal();
+		~Journal();							//commits pending records and closes the file
+
+		bool open(const std::string& path, std::vector<JournalRecord>& records);	//open or create a journal, reading its valid records into records
+		bool isOpen() const;
+		uint64_t append(const JournalRecord& record);	//queue a record, return its sequence number
+		bool waitDurable(uint64_t seq);		//wait until record seq is on disk, return false if writing failed
+		bool truncate();					//commit pending records and empty the journal (after a snapshot)
+		void close();						//commit pending records and close the file
+};
+
+#endif
@@ -11,208 +11,346 @@
 #include <sstream>
 #include <fstream>
 #include <limits>
+#include <climits>
 #include <algorithm>
 #include <cctype>
+#include <cstring>
 #include <vector>
+#include <thread>
 #include "tree.h"
 #include "myvector.h"
 #include "borrower.h"
 #include "book.h"
 #include "lcms.h"
+#include "mappedfile.h"
+#include "bookparser.h"
+#include "csvwriter.h"
+#include "journal.h"
+#include "isbn.h"
+#include "stats.h"
+#include "trace.h"
 
 using namespace std;
 
+//Function to describe a status of the programmatic API
+const char* statusMessage(CatalogStatus status){
+    switch (status) {
+        case CATALOG_OK:               return "OK";
+        case CATALOG_NOT_FOUND:        return "Book or category cannot be found!";
+        case CATALOG_NO_COPIES:        return "No copies available!";
+        case CATALOG_NOT_BORROWER:     return "Borrower's information does not match any current borrower for this book.";
+        case CATALOG_DUPLICATE_ISBN:   return "A book with this ISBN is already in the catalog!";
+        case CATALOG_INVALID_ARGUMENT: return "Invalid value!";
+        case CATALOG_ROOT_CATEGORY:    return "Cannot remove the root category!";
+    }
+    return "Unknown status!";
+}
+
 //Constructor
-LCMS::LCMS(string name){
+LCMS::LCMS(string name) : authorIndex(&authorNames) {
     //Create a library tree
     libTree = new Tree(name);
 }
 
 //Deconstructor
 LCMS::~LCMS(){
+    //Deallocate the library tree, its books and the borrowers
+    clearCatalog();
+}
+
+//Function to delete the whole catalog
+void LCMS::clearCatalog(){
+    //Deallocate every book at once (nodes do not own their books)
+    columns.clear();
+    titleSearch.clear();
+    authorIndex.clear();
+    yearIndex.clear();
+    isbnIndex.clear();
+    bookPool.releaseAll();
+    //No book refers to the author names any more
+    authorNames.clear();
     //Deallocate the memory space for the library tree
     delete libTree;
-    //Dynamically deallocate the memory space for borrowers, deleting each borrower 
-    for (int i = 0; i < borrowers.size(); i++){
-        delete borrowers[i];
+    libTree = nullptr;
+    titleIndex.clear();
+    borrowers.clear();
+}
+
+//Function to pick the stripe lock of an object by hashing its address
+std::mutex& LCMS::stripeOf(std::mutex* stripes, const void* object){
+    //Objects come from slab pools, so neighbouring addresses are mixed before taking the top bits
+    unsigned long long h = (unsigned long long)(uintptr_t)object;
+    h = (h ^ (h >> 29)) * 0x9e3779b97f4a7c15ULL;
+    return stripes[(h >> 32) % LOCK_STRIPES];
+}
+
+//Function to find a book by its title through the title index
+Book* LCMS::lookupBook(const string& title){
+    //Look up the title in the index and return the book if it exists
+    TitleEntry* entry = titleIndex.find(title);
+    return entry ? entry->first : nullptr;
+}
+
+//Function to find a book by its normalized ISBN through the ISBN index
+Book* LCMS::lookupIsbn(unsigned long long key){
+    Book** book = isbnIndex.find(key);
+    return book ? *book : nullptr;
+}
+
+//Function to put a book into a category and register it in the indexes
+void LCMS::attachBook(Node* node, Book* book){
+    //Append the book to the category and remember which category holds it
+    node->books.push_back(book);
+    book->node = node;
+    //Add the book to the title index
+    indexBook(book);
+}
+
+//Function to add a book to the title, title search, author, year and ISBN indexes and the book columns
+void LCMS::indexBook(Book* book){
+    columns.add(book);
+    titleSearch.add(book);
+    authorIndex.add(book);
+    yearIndex.add(book);
+    indexIsbn(book);
+    TitleEntry* entry = titleIndex.find(book->title);
+    //If another book already has this title, then link the book after it so the first one keeps being found
+    book->nextSameTitle = nullptr;
+    if (entry){
+        book->prevSameTitle = entry->last;
+        entry->last->nextSameTitle = book;
+        entry->last = book;
+    } else {
+        book->prevSameTitle = nullptr;
+        TitleEntry newEntry = {book, book};
+        titleIndex.insert(book->title, newEntry);
+    }
+}
+
+//Function to remove a book that is indexed under the given title
+void LCMS::unindexBook(Book* book, const string& title){
+    columns.remove(book);
+    titleSearch.remove(book);
+    authorIndex.remove(book);
+    yearIndex.remove(book, book->publication_year);
+    unindexIsbn(book);
+    TitleEntry* entry = titleIndex.find(title);
+    if (!entry){
+        return;
+    }
+    //Unlink the book from the books with this title; the next one takes its place
+    if (book->prevSameTitle) book->prevSameTitle->nextSameTitle = book->nextSameTitle;
+    else entry->first = book->nextSameTitle;
+    if (book->nextSameTitle) book->nextSameTitle->prevSameTitle = book->prevSameTitle;
+    else entry->last = book->prevSameTitle;
+    book->prevSameTitle = book->nextSameTitle = nullptr;
+    //If it was the last book with this title, then drop the entry
+    if (!entry->first){
+        titleIndex.erase(title);
+    }
+}
+
+//Function to add a book to the ISBN index
+void LCMS::indexIsbn(Book* book){
+    unsigned long long key;
+    book->isbnKey = normalizeIsbn(book->isbn, key) ? key : 0;
+    //A book whose ISBN is not valid, or is already taken by another book, cannot be found by ISBN
+    if (book->isbnKey != 0) {
+        isbnIndex.insert(book->isbnKey, book);
+    }
+}
+
+//Function to remove a book from the ISBN index
+void LCMS::unindexIsbn(Book* book){
+    if (book->isbnKey != 0 && lookupIsbn(book->isbnKey) == book) {
+        isbnIndex.erase(book->isbnKey);
     }
+    book->isbnKey = 0;
+}
+
+//Function to update the indexes of a book whose fields or category changed
+void LCMS::refreshBook(Book* book){
+    columns.refresh(book);
 }
 
 //Function that imports books from CSV file
 int LCMS::import(std::string path) {
-    //Open the file at the provided path 
-    std::ifstream inputFile(path);
+    STATS_START(timer, "import");
+    TraceSpan span("import");
+    span.arg("path", path);
+    //Map the file at the provided path into memory
+    STATS_START(parseTimer, "import.parse");
+    TraceSpan readSpan("import.read");
+    MappedFile inputFile;
 
     //If file cannot be opened, display the error message 
-    if (!inputFile.is_open()) {
+    if (!inputFile.open(path)) {
         std::cerr << "We can't open the file you have provided me with, which is " << path << std::endl;
         return -1; //Return -1 if the file cannot be oepned 
     }
+    readSpan.arg("bytes", (long long)inputFile.size());
+    readSpan.end();
+
+    const char* begin = inputFile.data();
+    const char* end = begin + inputFile.size();
+    //Skip the header line (a file without a newline after the header has no records)
+    if (begin < end) {
+        begin = std::min(findLineEnd(begin, end) + 1, end);
+    }
 
-    std::string line;
-    getline(inputFile, line); //Skip the header line
-    int bookCount = 0; //Counter for imported books 
+    //Parse the lines into batches of records, using a thread per core for large files
+    int threads = (int)std::thread::hardware_concurrency();
+    std::vector<ParseBatch> batches;
+    TraceSpan parseSpan("import.parse");
+    parseCatalog(begin, end, threads > 0 ? threads : 1, batches);
+    parseSpan.arg("chunks", (long long)batches.size());
+    parseSpan.end();
+    STATS_STOP(parseTimer);
 
-    //Read each line in the given file 
-    while (getline(inputFile, line)) {
-        //Stream to parse line
-        std::istringstream inputString(line);
-        //Vector that is going to store parsed fields for each book's attribute
-        std::vector<std::string> bookData;
-        std::string field;
-        bool insideQuotes = false; //Create a flag to handle quoted areas
-        //Variable that is going to store the current field 
-        std::string currentField;
-
-        //Parse the line character by character to handle fields with some quotes
-        for (size_t i = 0; i < line.size(); ++i) {
-            char ch = line[i]; 
-            if (ch == '\"') {
-                insideQuotes = !insideQuotes; //Toggle the state of quote by adding ! 
-            } else if (ch == ',' && !insideQuotes) {
-                //Add the currentField to bookData if comma is encountered outside quotes
-                bookData.push_back(currentField);
-                //Clear currentField in order to start a new field
-                currentField.clear();
+    int bookCount = 0; //Counter for imported books 
+    //Report the lines that could not be parsed, in the order they appear in the file
+    for (size_t b = 0; b < batches.size(); b++) {
+        for (size_t i = 0; i < batches[b].errors.size(); i++) {
+            const ParseError& error = batches[b].errors[i];
+            if (error.status == PARSE_BAD_FORMAT) {
+                std::cerr << "Error has occured. Invalid format in line: " << error.line << std::endl;
+            } else if (error.status == PARSE_BAD_COPIES) {
+                std::cerr << "Error has occured. Invalid total or available copies in line: " << error.line << std::endl;
             } else {
-                //Add character to current field if it is inside the quotes or is not a comma 
-                currentField += ch;
+                std::cerr << "Error: Invalid publication year in line: " << error.line << std::endl;
             }
         }
-        if (!currentField.empty()) {
-            //If not empty, then append the last field to bookData 
-            bookData.push_back(currentField);
-        }
-
-        //Create an if-statement to check if the line includes the required number of bookData
-        if (bookData.size() < 7) {
-            std::cerr << "Error has occured. Invalid format in line: " << line << std::endl;
-            continue; //Skip this line if it does not have enough fields 
-        }
-
-        //Assign each book's atttribute from the bookData
-        std::string title = bookData[0];
-        std::string author = bookData[1];
-        std::string isbn = bookData[2];
-        std::string publicationYear = bookData[3];
-        std::string category = bookData[4];
-        int totalCopies = 0;
-        int availableCopies = 0;
-
-        //Change totalCopies and availableCopies to integers
-        try {
-            totalCopies = std::stoi(bookData[5]);
-            availableCopies = std::stoi(bookData[6]);
-        } catch (const std::invalid_argument&) {
-            std::cerr << "Error has occured. Invalid total or available copies in line: " << line << std::endl;
-            continue; //Skip this line if it fails the conversion 
-        }
+    }
 
-        //Convert publicationYear to a integer
-        int pubYearInteger = 0; //Initialize pubYearInteger to 0
-        try {
-            pubYearInteger = std::stoi(publicationYear);
-        } catch (const std::exception&) {
-            std::cerr << "Error: Invalid publication year in line: " << line << std::endl;
-            continue; //If it fails the conversion then skip this line
-        }
-
-        //Create a new Book object with parsed attributes
-        Book* newBook = new Book(title, author, isbn, pubYearInteger, totalCopies, availableCopies);
-        bookCount++; //Increment the bookcount by 1
-
-        //Process category path so as to add nested categories inside the library tree
-        std::stringstream categoryStream(category); //Stream to parse category path
-        std::string categoryToken; //String variable to store each cateogry level
-        //Create a pointer called currentNode to start from the root of the library tree
-        Node* currentNode = libTree->getRoot();
-
-        //Iterate through each category level 
-        while (getline(categoryStream, categoryToken, '/')) {
-            //Create pointer called childNode to get child node for current category level
-            Node* childNode = libTree->getChild(currentNode, categoryToken);
-            //If category level does not exist, then make it 
-            if (!childNode) {
-                libTree->insert(currentNode, categoryToken); //Add new category into the tree
-                childNode = libTree->getChild(currentNode, categoryToken); //Get category node that just got newly created 
+    //Merge the batches into the library tree in file order, without walking up the parents for every book
+    //(the file is mapped and parsed before taking the lock, so other desks only wait for the merge)
+    STATS_START(lockTimer, "import.lock");
+    TraceSpan lockSpan("import.lock");
+    WriteGuard guard(catalogLock);
+    lockSpan.end();
+    STATS_STOP(lockTimer);
+    STATS_START(mergeTimer, "import.merge");
+    TraceSpan mergeSpan("import.merge");
+    //While tracing, time the category resolution (Tree::getNode, getChild and insert) apart from creating and indexing the books
+    bool traced = TraceLog::enabled();
+    std::chrono::steady_clock::duration resolving(0);
+    long long resolutions = 0;
+    libTree->beginBulkLoad();
+    FieldView lastCategory = {nullptr, 0}; //Category path of the previous record
+    Node* lastNode = nullptr; //Category node of the previous record
+    for (size_t b = 0; b < batches.size(); b++) {
+        std::vector<BookRecord>& records = batches[b].records;
+        for (size_t i = 0; i < records.size(); i++) {
+            const BookRecord& record = records[i];
+            //ISBN is the unique key of a book, so a valid ISBN that is already in the catalog is skipped
+            unsigned long long isbnKey;
+            if (normalizeIsbn(record.isbn.data, record.isbn.size, isbnKey) && lookupIsbn(isbnKey)) {
+                std::cerr << "Error: Duplicate ISBN " << record.isbn.str() << " for '" << record.title.str() << "', the book is skipped." << std::endl;
+                continue;
+            }
+            //Create a new Book object with parsed attributes
+            Book* newBook = bookPool.create(record.title.str(), authorNames.intern(record.author.data, record.author.size), record.isbn.str(), record.publicationYear, record.totalCopies, record.availableCopies);
+            bookCount++; //Increment the bookcount by 1
+
+            //Consecutive lines usually share a category, so its path is only resolved when it changes
+            Node* currentNode = lastNode;
+            if (!currentNode || !(record.category == lastCategory)) {
+                std::chrono::steady_clock::time_point resolveStart;
+                if (traced) resolveStart = std::chrono::steady_clock::now();
+                //Look the whole path up; only a category that does not exist yet is walked from the root
+                currentNode = libTree->getNode(record.category.data, record.category.size);
+                const char* token = record.category.data;
+                const char* categoryEnd = token + record.category.size;
+                if (currentNode) token = categoryEnd;
+                else currentNode = libTree->getRoot();
+
+                //Iterate through each category level separated by '/'
+                while (token < categoryEnd) {
+                    const char* slash = (const char*)memchr(token, '/', categoryEnd - token);
+                    if (!slash) slash = categoryEnd;
+                    std::string categoryToken(token, slash);
+                    //Create pointer called childNode to get child node for current category level
+                    Node* childNode = libTree->getChild(currentNode, categoryToken);
+                    //If category level does not exist, then make it 
+                    if (!childNode) {
+                        libTree->insert(currentNode, categoryToken); //Add new category into the tree
+                        childNode = libTree->getChild(currentNode, categoryToken); //Get category node that just got newly created 
+                    }
+                    //Move to the next level in category path 
+                    currentNode = childNode;
+                    token = slash < categoryEnd ? slash + 1 : categoryEnd;
+                }
+                lastCategory = record.category;
+                lastNode = currentNode;
+                if (traced) {
+                    resolving += std::chrono::steady_clock::now() - resolveStart;
+                    resolutions++;
+                }
             }
-            //Move to the next level in category path 
-            currentNode = childNode;
-        }
-
-        //Append the book to the last category node using push_back function from myvector.h
-        currentNode->books.push_back(newBook);
-        //Update book count
-        currentNode->bookCount++; 
 
-        //Update the book count inside all the parent nodes
-        Node* parentNode = currentNode->parent;
-        while (parentNode) {
-            parentNode->bookCount++; //Increment bookCount by one for each parent node
-            parentNode = parentNode->parent; //Move to the next parent
+            //Append the book to the last category node and add it to the title index (counts are updated after the merge)
+            attachBook(currentNode, newBook);
         }
     }
+    mergeSpan.arg("books", bookCount);
+    mergeSpan.arg("categoryResolutions", resolutions);
+    mergeSpan.arg("categoryResolveUs", (long long)std::chrono::duration_cast<std::chrono::microseconds>(resolving).count());
+    mergeSpan.end();
+    //Recompute the book counts of all the categories in one pass
+    libTree->endBulkLoad();
+    STATS_STOP(mergeTimer);
 
     //Display the amount of books that have been imported 
     std::cout << bookCount << " records have been imported successfully." << std::endl;
-    inputFile.close(); //Close the file 
     return bookCount; //Return the amount of books 
 }
 
 //Function to export all books to the given file
 void LCMS::exportData(std::string path) {
+    STATS_START(timer, "export");
+    TraceSpan span("export");
+    span.arg("path", path);
     //Open the output file 
-    std::ofstream outputFile(path);
+    CsvWriter outputFile;
 
     //If the file cannot be opened, then print out the error message 
-    if (!outputFile.is_open()) {
+    if (!outputFile.open(path)) {
         std::cerr << "We can't open the provided file, which is " << path << std::endl;
         return;
     }
 
-    //Write the header row to the file 
-    outputFile << "Title,Author,ISBN,Publication Year,Total Copies,Available Copies\n";
-
-    //Create stack to hold nodes in order to traverse the library tree
-    MyVector<Node*> nodes_stack;
-    //Start from the root node of the library tree
-    nodes_stack.push_back(libTree->getRoot());
+    //Write the header row to the file, with the same columns import reads
+    outputFile.writeRaw("Title,Author,ISBN,Publication Year,Category,Total Copies,Available Copies\n");
 
-    //Loop untill we do not find any nodes in the stack 
-    while (!nodes_stack.empty()) {
-        //Take the last node from the stack 
-        Node* currentNode = nodes_stack.back();
-        //Remove the last node from the stack 
-        nodes_stack.erase(nodes_stack.size() - 1);
-
-        //Iterate through all books in the current node 
-        for (size_t i = 0; i < currentNode->books.size(); ++i) {
-            //Create a book pointer 
-            Book* book = currentNode->books[i];
-            //Write the details of the book into the file
-            outputFile << book->title << ","
-                       << book->author << ","
-                       << book->isbn << ","
-                       << book->publication_year << ","
-                       << book->total_copies << ","
-                       << book->available_copies << "\n";
-        }
-
-        //Use for loop to push all children of the currentNode onto the stack 
-        for (size_t i = 0; i < currentNode->children.size(); ++i) {
-            nodes_stack.push_back(currentNode->children[i]);
-        }
+    //Write the books of every category, starting from the root of the library tree
+    {
+        STATS_START(writeTimer, "export.write");
+        TraceSpan writeSpan("export.write");
+        ReadGuard guard(catalogLock);
+        writeSpan.arg("books", libTree->exportData(libTree->getRoot(), outputFile, authorNames));
     }
 
     //Close the file 
-    outputFile.close();
+    STATS_START(closeTimer, "export.close");
+    TraceSpan closeSpan("export.close");
+    bool written = outputFile.close();
+    closeSpan.end();
+    STATS_STOP(closeTimer);
+    if (!written) {
+        std::cerr << "Failed to write the data to: " << path << std::endl;
+        return;
+    }
     std::cout << "Data has been exported successfully to: " << path << std::endl;
 }
 
 //Function to find all the books in the specified category 
 void LCMS::findAll(string category) {
+    STATS_START(timer, "findAll");
+    ReadGuard guard(catalogLock);
     //Create a node called categoryNode for the specified node 
+    STATS_START(lookupTimer, "findAll.lookup");
     Node* categoryNode = libTree->getNode(category);
+    STATS_STOP(lookupTimer);
     //If categoryNode is not found, then
     if (categoryNode == nullptr){
         //Print out an error message indicating that category is not found
@@ -221,37 +359,222 @@ void LCMS::findAll(string category) {
         return; 
     }
     //Display all the books in the category and its subcategories by calling printAll function on specific category 
-    libTree->printAll(categoryNode); 
+    STATS_START(outputTimer, "findAll.output");
+    libTree->printAll(categoryNode, authorNames); 
 }
 
 //Function to find the book with the specified title 
 void LCMS::findBook(string bookTitle){
-    //Create a pointer called current that points to the root of the library tree
-    Node* current = libTree->getRoot();
-    //Declare boolean variable and set it to false so that we can know if the book is found or not 
-    bool flag = false;
-    
-    //Iterate through all the children to search for a book 
-    for (int i = 0; i < current->children.size(); i++){
-        //Create a book pointer and call the findbook function on each child to search for the book with the specified title 
-        Book* book = libTree->findBook(current, bookTitle);
-        //If the book is found, then
-        if (book){
-            //Display the details of the book
-            book->display();
-            //Set flag to be true
-            flag = true;
-            //Exit the loop
-            break;
-        }
+    STATS_START(timer, "findBook");
+    ReadGuard guard(catalogLock);
+    //Look up the book with the specified title in the title index
+    STATS_START(lookupTimer, "findBook.lookup");
+    Book* book = lookupBook(bookTitle);
+    STATS_STOP(lookupTimer);
+    STATS_START(outputTimer, "findBook.output");
+
+    //If the book is found, then display the details of the book
+    if (book){
+        book->display(authorNames);
+    } else {
+        //If no book was found, then print an error message saying that the book was not found
+        cout << "The book was not found!" << endl;
     }
+}
+
+//Function to copy the details of a book into a BookInfo
+void LCMS::describeBook(Book* book, BookInfo& info) {
+    info.title = book->title;
+    info.author = book->getAuthor(authorNames);
+    info.isbn = book->isbn;
+    info.publicationYear = book->publication_year;
+    info.totalCopies = book->total_copies;
+    info.availableCopies = book->available_copies;
+    info.category = book->node->getCategory(book->node);
+}
 
-    //If no book was found, then print an error message saying that the book was not found
-    if (!flag){
+//Function to return the details of the book with the given title
+CatalogStatus LCMS::getBook(const string& title, BookInfo& info) {
+    ReadGuard guard(catalogLock);
+    Book* book = lookupBook(title);
+    if (!book) {
+        return CATALOG_NOT_FOUND;
+    }
+    describeBook(book, info);
+    return CATALOG_OK;
+}
+
+//Function to count the current borrowers of a book
+CatalogStatus LCMS::getBorrowerCount(const string& title, int& count) {
+    ReadGuard guard(catalogLock);
+    Book* book = lookupBook(title);
+    if (!book) {
+        return CATALOG_NOT_FOUND;
+    }
+    //The loan list of the book is changed by circulation desks under its stripe
+    std::lock_guard<std::mutex> stripe(stripeOf(bookStripes, book));
+    count = book->currentBorrowers.size();
+    return CATALOG_OK;
+}
+
+//Function to count the books a borrower currently holds
+int LCMS::getLoanCount(const string& name, const string& id) {
+    ReadGuard guard(catalogLock);
+    Borrower* borrower = borrowers.find(name, id);
+    if (!borrower) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> stripe(stripeOf(borrowerStripes, borrower));
+    return borrower->books_borrowed.size();
+}
+
+//Function to return the details of the book with the given ISBN-10 or ISBN-13
+CatalogStatus LCMS::getBookByIsbn(const string& isbn, BookInfo& info) {
+    unsigned long long key;
+    if (!normalizeIsbn(isbn, key)) {
+        return CATALOG_INVALID_ARGUMENT;
+    }
+    ReadGuard guard(catalogLock);
+    Book* book = lookupIsbn(key);
+    if (!book) {
+        return CATALOG_NOT_FOUND;
+    }
+    describeBook(book, info);
+    return CATALOG_OK;
+}
+
+//Function to find the book with the given ISBN
+void LCMS::findByIsbn(string isbn) {
+    STATS_START(timer, "findByIsbn");
+    //Normalize the ISBN (ISBN-10 or ISBN-13, with or without hyphens) to its key
+    unsigned long long key;
+    if (!normalizeIsbn(isbn, key)) {
+        cerr << "'" << isbn << "' is not a valid ISBN!" << endl;
+        return;
+    }
+    //Look the key up in the ISBN index
+    ReadGuard guard(catalogLock);
+    Book* book = lookupIsbn(key);
+    if (book) {
+        book->display(authorNames);
+    } else {
         cout << "The book was not found!" << endl;
     }
 }
 
+//Function to list the books whose title contains the given fragment, ignoring case
+void LCMS::searchTitle(string fragment) {
+    STATS_START(timer, "searchTitle");
+    //If no fragment is given, then display an error message
+    if (fragment.empty()) {
+        cerr << "Please enter part of a title!" << endl;
+        return;
+    }
+    //Look the fragment up in the title search index, keeping the best matches
+    ReadGuard guard(catalogLock);
+    const int shown = 20;
+    MyVector<Book*> matches;
+    int count = titleSearch.search(fragment, shown, matches);
+    if (count == 0) {
+        cout << "No title contains '" << fragment << "'." << endl;
+        return;
+    }
+    //Display each match with its category
+    cout << count << (count == 1 ? " title contains '" : " titles contain '") << fragment << "':" << endl;
+    for (int i = 0; i < matches.size(); i++) {
+        cout << matches[i]->title << " (" << matches[i]->node->getCategory(matches[i]->node) << ")" << endl;
+    }
+    if (count > matches.size()) {
+        cout << "... and " << count - matches.size() << " more." << endl;
+    }
+}
+
+//Function to display the books of an author ("<author>[|<category>]")
+void LCMS::findByAuthor(string parameter) {
+    STATS_START(timer, "findByAuthor");
+    //Split the parameter into the author and the optional category
+    size_t bar = parameter.find('|');
+    string author = parameter.substr(0, bar);
+    string category = bar == string::npos ? "" : parameter.substr(bar + 1);
+
+    //Find the category that limits the search (the root if none is given)
+    ReadGuard guard(catalogLock);
+    Node* categoryNode = libTree->getNode(category);
+    if (!categoryNode) {
+        cerr << "Category is not found!" << endl;
+        return;
+    }
+
+    //Look the author up in the author index
+    const MyVector<Book*>* books = authorIndex.find(author);
+    int count = 0;
+    if (books) {
+        for (int i = 0; i < books->size(); i++) {
+            Book* book = (*books)[i];
+            //Keep the book only if the category is one of its ancestors
+            Node* node = book->node;
+            while (node && node != categoryNode) {
+                node = node->parent;
+            }
+            if (node) {
+                book->display(authorNames);
+                count++;
+            }
+        }
+    }
+    if (count == 0) {
+        cout << "No books by '" << author << "' were found!" << endl;
+    } else {
+        cout << count << (count == 1 ? " book" : " books") << " found." << endl;
+    }
+}
+
+//Function to display the books published in a range of years ("<from> <to> [category]")
+void LCMS::findByYear(string parameter) {
+    STATS_START(timer, "findByYear");
+    //Read the range of years; the rest of the line is the optional category
+    stringstream sstr(parameter);
+    int fromYear, toYear;
+    if (!(sstr >> fromYear >> toYear) || fromYear > toYear) {
+        cerr << "Please enter a valid range of years, e.g. findByYear 1950 1970 History" << endl;
+        return;
+    }
+    string category;
+    getline(sstr >> ws, category);
+
+    //Find the category that limits the search (the root if none is given)
+    ReadGuard guard(catalogLock);
+    Node* categoryNode = libTree->getNode(category);
+    if (!categoryNode) {
+        cerr << "Category is not found!" << endl;
+        return;
+    }
+    MyVector<unsigned char> selected;
+    if (categoryNode != libTree->getRoot()) {
+        selected.reserve(libTree->nodeIdLimit());
+        for (unsigned int i = 0; i < libTree->nodeIdLimit(); i++) {
+            selected.push_back(0);
+        }
+        libTree->markSubtree(categoryNode, selected);
+    }
+
+    //Seek to the first year in the year index and scan to the last one
+    MyVector<Book*> books;
+    yearIndex.search(fromYear, toYear, books);
+    int count = 0;
+    for (int i = 0; i < books.size(); i++) {
+        if (selected.empty() || selected[books[i]->node->id]) {
+            books[i]->display(authorNames);
+            count++;
+        }
+    }
+    if (count == 0) {
+        cout << "No books published between " << fromYear << " and " << toYear << " were found!" << endl;
+    } else {
+        cout << count << (count == 1 ? " book" : " books") << " found." << endl;
+    }
+}
+
 //Function to add a new book to the catalog 
 void LCMS::addBook() {
     //Declare variables to store the details of the book 
@@ -286,35 +609,73 @@ void LCMS::addBook() {
         return;
     }
 
-    //Create a book object called newBook with the details inputted by user
-    Book* newBook = new Book(title, author, isbn, pubYearInteger, totalCopies, availableCopies);
+    //Warn about ISBNs that are not valid, since such a book cannot be found by ISBN
+    unsigned long long isbnKey;
+    if (!normalizeIsbn(isbn, isbnKey)) {
+        cout << "Warning: '" << isbn << "' is not a valid ISBN-10 or ISBN-13, so the book cannot be found by ISBN." << endl;
+    }
+
+    //Add a book with the details inputted by user to the catalog; ISBN is the unique key of a book
+    bool newCategory = !hasCategory(category);
+    BookInfo info = {title, author, isbn, pubYearInteger, totalCopies, availableCopies, category};
+    if (addBook(info) == CATALOG_DUPLICATE_ISBN) {
+        BookInfo existing;
+        getBookByIsbn(isbn, existing);
+        cerr << "A book with ISBN " << isbn << " is already in the catalog: " << existing.title << endl;
+        return;
+    }
+
+    //If the category did not exist, then it has been created along with the book
+    if (newCategory) {
+        cout << "Category '" << category << "' not found. Creating new category." << endl;
+    }
+    cout << title << " has been successfully added to the catalog." << endl;
+}
+
+//Function to add a new book to the catalog without console input/output
+CatalogStatus LCMS::addBook(const BookInfo& info) {
+    STATS_START(timer, "api.addBook");
+    uint64_t seq;
+    {
+        WriteGuard guard(catalogLock);
+        //ISBN is the unique key of a book: refuse a second book with the same ISBN
+        unsigned long long isbnKey;
+        if (normalizeIsbn(info.isbn, isbnKey) && lookupIsbn(isbnKey)) {
+            return CATALOG_DUPLICATE_ISBN;
+        }
+
+        //Create the book (and its category if it does not exist) and record it in the journal
+        insertBook(info.title, info.author, info.isbn, info.publicationYear, info.totalCopies, info.availableCopies, info.category);
+        seq = queueChange(JOURNAL_ADD_BOOK, {info.title, info.author, info.isbn, to_string(info.publicationYear), to_string(info.totalCopies), to_string(info.availableCopies), info.category});
+    }
+    //Wait for the journal after releasing the lock, so other desks are not held up by the disk
+    awaitChange(seq);
+    return CATALOG_OK;
+}
+
+//Function to create a book in the given category (the category is created if it does not exist)
+Book* LCMS::insertBook(const string& title, const string& author, const string& isbn, int publicationYear, int totalCopies, int availableCopies, const string& category) {
+    //Create a book object called newBook with the given details
+    Book* newBook = bookPool.create(title, author, isbn, publicationYear, totalCopies, availableCopies, authorNames);
 
-    //Create a node called categoryNode
+    //Create a node called categoryNode, creating the category if needed
     Node* categoryNode = libTree->getNode(category);
-    //If the category does not exist, then 
     if (categoryNode == nullptr) {
-        //Create a new category 
-        cout << "Category '" << category << "' not found. Creating new category." << endl;
         categoryNode = libTree->createNode(category);
     }
 
     //Append a new book to the book list of the provided category 
-    categoryNode->books.push_back(newBook);
+    attachBook(categoryNode, newBook);
     //Update the book count in the library tree
     libTree->updateBookCount(categoryNode, 1);
-
-    cout << title << " has been successfully added to the catalog." << endl;
+    return newBook;
 }
 
 //Function to edit details of the book 
 void LCMS::editBook(std::string bookTitle) {
-    //Create a node called currentNode to start from the root of the library tree
-    Node* currentNode = libTree->getRoot();
-    //Create a book object to find the book with the specified title 
-    Book* book = libTree->findBook(currentNode, bookTitle);
-
-    //If the book is found then 
-    if (book) {
+    //If the book is found then (each edit finds it again by title, since other desks may change the catalog meanwhile)
+    BookInfo info;
+    if (getBook(bookTitle, info) == CATALOG_OK) {
         int choice;
         do {
             //Ask user input for which detail of the book they want to edit 
@@ -336,7 +697,8 @@ void LCMS::editBook(std::string bookTitle) {
                     std::string newTitle;
                     std::cout << "Enter new title: ";
                     std::getline(std::cin, newTitle); //Obtain new title 
-                    if (!newTitle.empty()) book->title = newTitle; //Update the title if not empty 
+                    //Update the title if not empty and keep editing the book under its new title
+                    if (editBook(bookTitle, BOOK_TITLE, newTitle) == CATALOG_OK) bookTitle = newTitle;
                     std::cout << "Title is now updated!" << std::endl;
                     break;
                 }
@@ -344,7 +706,7 @@ void LCMS::editBook(std::string bookTitle) {
                     std::string newAuthor;
                     std::cout << "Enter new author: ";
                     std::getline(std::cin, newAuthor); //Get the new author's name 
-                    if (!newAuthor.empty()) book->author = newAuthor; //Update author detail if not empty 
+                    editBook(bookTitle, BOOK_AUTHOR, newAuthor); //Update author detail if not empty 
                     std::cout << "Author is now updated!" << std::endl;
                     break;
                 }
@@ -352,15 +714,19 @@ void LCMS::editBook(std::string bookTitle) {
                     std::string newISBN;
                     std::cout << "Enter new ISBN: ";
                     std::getline(std::cin, newISBN); //Get new ISBN 
-                    if (!newISBN.empty()) book->isbn = newISBN; //Update ISBN if not empty 
-                    std::cout << "ISBN is now updated!" << std::endl;
+                    //Update ISBN if not empty and not the ISBN of another book
+                    if (editBook(bookTitle, BOOK_ISBN, newISBN) == CATALOG_OK) {
+                        std::cout << "ISBN is now updated!" << std::endl;
+                    } else {
+                        std::cerr << "ISBN is empty or belongs to another book!" << std::endl;
+                    }
                     break;
                 }
                 case 4: {
                     int newPublicationYear;
                     std::cout << "Enter new publication year: ";
                     std::cin >> newPublicationYear; //Get user input for publication year 
-                    if (std::cin) book->publication_year = newPublicationYear; 
+                    if (std::cin) editBook(bookTitle, BOOK_PUBLICATION_YEAR, to_string(newPublicationYear)); 
                     std::cout << "Publication year is now updated!" << std::endl;
                     cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); //Clear the input buffer
                     break;
@@ -369,7 +735,7 @@ void LCMS::editBook(std::string bookTitle) {
                     int newTotalCopies;
                     std::cout << "Enter new total copies: ";
                     std::cin >> newTotalCopies; //Get user input for new total copies 
-                    if (std::cin) book->total_copies = newTotalCopies;
+                    if (std::cin) editBook(bookTitle, BOOK_TOTAL_COPIES, to_string(newTotalCopies));
                     std::cout << "Total copies are now updated!" << std::endl;
                     cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');  //Clear the input buffer 
                     break;
@@ -378,7 +744,7 @@ void LCMS::editBook(std::string bookTitle) {
                     int newAvailableCopies;
                     std::cout << "Enter new available copies: ";
                     std::cin >> newAvailableCopies; //Get user input for new available copies 
-                    if (std::cin) book->available_copies = newAvailableCopies;
+                    if (std::cin) editBook(bookTitle, BOOK_AVAILABLE_COPIES, to_string(newAvailableCopies));
                     std::cout << "Available copies are now updated!" << std::endl;
                     cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');  //Clear the input buffer 
                     break;
@@ -397,66 +763,164 @@ void LCMS::editBook(std::string bookTitle) {
     }
 }
 
+//Function to edit one field of the book with the given title and record the change in the journal
+CatalogStatus LCMS::editBook(const string& title, BookField field, const string& value) {
+    STATS_START(timer, "api.editBook");
+    uint64_t seq;
+    {
+        WriteGuard guard(catalogLock);
+        Book* book = lookupBook(title);
+        if (!book) {
+            return CATALOG_NOT_FOUND;
+        }
+        //A value that is empty, unchanged, not a number or the ISBN of another book leaves the book as it is
+        try {
+            if (!setBookField(book, field, value)) {
+                return CATALOG_INVALID_ARGUMENT;
+            }
+        } catch (const std::exception&) {
+            return CATALOG_INVALID_ARGUMENT;
+        }
+        //Record the change under the title the book had before the edit
+        seq = queueChange(JOURNAL_EDIT_BOOK, {title, to_string(field), value});
+    }
+    awaitChange(seq);
+    return CATALOG_OK;
+}
+
+//Function to set a field of a book, numbered as in the edit menu (1 title ... 6 available copies)
+bool LCMS::setBookField(Book* book, int field, const string& value) {
+    switch (field) {
+        case 1:
+            //Update the title if not empty and move the book to its new title in the index
+            if (value.empty() || value == book->title) return false;
+            {
+                string oldTitle = book->title;
+                book->title = value;
+                unindexBook(book, oldTitle);
+                indexBook(book);
+            }
+            return true;
+        case 2:
+            if (value.empty()) return false;
+            //Move the book to the list of its new author in the author index
+            authorIndex.remove(book);
+            book->setAuthor(authorNames, value);
+            authorIndex.add(book);
+            return true;
+        case 3: {
+            if (value.empty()) return false;
+            //Refuse an ISBN that another book already has
+            unsigned long long key;
+            if (normalizeIsbn(value, key) && lookupIsbn(key) && lookupIsbn(key) != book) return false;
+            unindexIsbn(book);
+            book->isbn = value;
+            indexIsbn(book);
+            return true;
+        }
+        case 4: {
+            //Move the book to its new year in the year index
+            int year = std::stoi(value);
+            yearIndex.remove(book, book->publication_year);
+            book->publication_year = year;
+            yearIndex.add(book);
+            refreshBook(book);
+            return true;
+        }
+        case 5:
+            book->total_copies = std::stoi(value);
+            refreshBook(book);
+            return true;
+        case 6:
+            book->available_copies = std::stoi(value);
+            refreshBook(book);
+            return true;
+        default:
+            return false;
+    }
+}
+
 //Function to borrow books 
 void LCMS::borrowBook(string bookTitle) {
     //Declare string variables called name and id 
     string name, id;
-    //Create a node called currentNode to start from the root of the library tree
-    Node* currentNode = libTree->getRoot();
-    //Create a Book objected called book to find the book with the specific title 
-    Book* book = libTree->findBook(currentNode, bookTitle);
+    //Check that the book with the specific title exists and has available copies
+    BookInfo info;
+    bool available = getBook(bookTitle, info) == CATALOG_OK && info.availableCopies > 0;
 
     //If book is found and there are available copies, then
-    if (book && book->available_copies > 0) {  
-        //Ask user input for their name and id 
+    if (available) {  
+        //Ask user input for their name and id (no lock is held while waiting for the user)
         cout << "Enter Borrower's name: ";
         getline(cin, name);
         cout << "Enter Borrower's id: ";
         getline(cin, id);
 
-        //Create a Borrower object called borrower and set it to nullptr 
-        Borrower* borrower = nullptr;
-        //Iterate through each borrower to see if the borrower already exists or not
-        for (int i = 0; i < borrowers.size(); i++) {
-            //If borrower's name and id matches the user input, then
-            if (borrowers[i]->name == name && borrowers[i]->id == id) {
-                //Set the pointer to the given borrower and exit the loop 
-                borrower = borrowers[i];
-                break;
-            }
+        //Issue a copy of the book to the borrower
+        if (borrowBook(bookTitle, name, id) == CATALOG_OK) {
+            cout << "Book '" << bookTitle << "' has been successfully issued to " << name << " (ID: " << id << ")." << endl;
+            return;
         }
+    }
+    //If there is no such book or no available copies, then display an error message indicating that status 
+    cerr << "Book not found or no copies available!" << endl;
+}
 
-        //If borrower does not exist, then
-        if (!borrower) {
-            //Create a new borrower with name and id
-            borrower = new Borrower(name, id);
-            //Add the newly created borrower to the list of borrowers
-            borrowers.push_back(borrower);
+//Function to issue a copy of the book with the given title to a borrower and record it in the journal
+CatalogStatus LCMS::borrowBook(const string& title, const string& name, const string& id) {
+    STATS_START(timer, "api.borrowBook");
+    uint64_t seq = 0;
+    {
+        //Circulation holds the catalog lock as a reader, so desks lending different books run in parallel
+        ReadGuard guard(catalogLock);
+        Book* book = lookupBook(title);
+        if (!book) {
+            return CATALOG_NOT_FOUND;
+        }
+        if (!lendBook(book, name, id, &seq)) {
+            return CATALOG_NO_COPIES;
         }
+    }
+    awaitChange(seq);
+    return CATALOG_OK;
+}
+
+//Function to issue a copy of a book to a borrower
+bool LCMS::lendBook(Book* book, const string& name, const string& id, uint64_t* journalSeq) {
+    //Claim a copy first: decrement the available copies by one unless another desk took the last copy
+    int available = book->available_copies.load();
+    do {
+        if (available <= 0) {
+            return false;
+        }
+    } while (!book->available_copies.compare_exchange_weak(available, available - 1));
+
+    //Look up the borrower in the registry, registering a new borrower if they do not exist yet
+    Borrower* borrower = borrowers.findOrCreate(name, id);
 
+    {
         //Add the borrower to the specified book's list of current borrowers
+        std::lock_guard<std::mutex> guard(stripeOf(bookStripes, book));
         book->currentBorrowers.push_back(borrower);
+        columns.refreshCopies(book);
+        //Queue the journal record while the book is locked, so the records of one book stay in order
+        if (journalSeq) {
+            *journalSeq = queueChange(JOURNAL_BORROW_BOOK, {book->title, name, id});
+        }
+    }
+    {
         //Add the book to the borrower's list of books that they have already borrowed
+        std::lock_guard<std::mutex> guard(stripeOf(borrowerStripes, borrower));
         borrower->books_borrowed.push_back(book);
-        //Decrement the available copies by one
-        book->available_copies--;
-
-        cout << "Book '" << bookTitle << "' has been successfully issued to " << name << " (ID: " << id << ")." << endl;
-    } else {
-        //If there is no such book or no available copies, then display an error message indicating that status 
-        cerr << "Book not found or no copies available!" << endl;
     }
+    return true;
 }
 
 //Function to return book
 void LCMS::returnBook(string bookTitle) {
-    //Create a new node called currentnode to start from the root of the library tree
-    Node* currentNode = libTree->getRoot();
-    //Create a Book objected called book to find the book with the specific title
-    Book* book = libTree->findBook(currentNode, bookTitle);
-
     //If the book is found, then
-    if (book) {
+    BookInfo info;
+    if (getBook(bookTitle, info) == CATALOG_OK) {
         //Ask user input for name and id 
         string name;
         string id;
@@ -465,54 +929,84 @@ void LCMS::returnBook(string bookTitle) {
         cout << "Enter borrower's id: ";
         getline(cin, id);
 
-        //Create a flag to check if the borrower was found or not
-        bool flag = false;  
+        //Take the copy back from the borrower; if borrower information doesn't match, display an error message
+        CatalogStatus status = returnBook(bookTitle, name, id);
+        if (status == CATALOG_OK) {
+            cout << "Book has been successfully returned." << endl;
+        } else if (status == CATALOG_NOT_BORROWER) {
+            cerr << "Borrower's information does not match any current borrower for this book." << endl;
+        } else {
+            cerr << "Book cannot be found!" << endl;
+        }
+    } else {
+        cerr << "Book cannot be found!" << endl;
+    }
+}
+
+//Function to take a copy of the book with the given title back from a borrower and record it in the journal
+CatalogStatus LCMS::returnBook(const string& title, const string& name, const string& id) {
+    STATS_START(timer, "api.returnBook");
+    uint64_t seq = 0;
+    {
+        ReadGuard guard(catalogLock);
+        Book* book = lookupBook(title);
+        if (!book) {
+            return CATALOG_NOT_FOUND;
+        }
+        if (!takeBackBook(book, name, id, &seq)) {
+            return CATALOG_NOT_BORROWER;
+        }
+    }
+    awaitChange(seq);
+    return CATALOG_OK;
+}
 
+//Function to take a copy of a book back from one of its current borrowers
+bool LCMS::takeBackBook(Book* book, const string& name, const string& id, uint64_t* journalSeq) {
+    Borrower* borrower = nullptr;
+    {
         //Search for the borrower in the current borrowers list for the book
+        std::lock_guard<std::mutex> guard(stripeOf(bookStripes, book));
         for (int i = 0; i < book->currentBorrowers.size(); i++) {
-            Borrower* borrower = book->currentBorrowers[i];
-            
-            //If name and id match, then
-            if (borrower->name == name && borrower->id == id) {
-                //Remove the borrower from the book's list of current borrowers by calling erase function 
+            //If name and id match, then remove the borrower from the book's list of current borrowers
+            if (book->currentBorrowers[i]->name == name && book->currentBorrowers[i]->id == id) {
+                borrower = book->currentBorrowers[i];
                 book->currentBorrowers.erase(i);
-
-                //Increment the available copies of the book by one
-                book->available_copies++;
-
-                //Use for loop to find and remove the book from the borrower's books_borrowed list
-                for (int j = 0; j < borrower->books_borrowed.size(); j++) {
-                    if (borrower->books_borrowed[j] == book) {
-                        borrower->books_borrowed.erase(j);
-                        break;
-                    }
-                }
-
-                cout << "Book has been successfully returned." << endl;
-                flag = true;  //Set the flag to true to indicate that the book has been successfully returned. 
                 break;
             }
         }
+        if (!borrower) {
+            return false;
+        }
+        //Increment the available copies of the book by one
+        book->available_copies++;
+        columns.refreshCopies(book);
+        if (journalSeq) {
+            *journalSeq = queueChange(JOURNAL_RETURN_BOOK, {book->title, name, id});
+        }
+    }
 
-        //If borrower information doesn't match, display an error message
-        if (!flag) {
-            cerr << "Borrower's information does not match any current borrower for this book." << endl;
+    //Use for loop to find and remove the book from the borrower's books_borrowed list
+    std::lock_guard<std::mutex> guard(stripeOf(borrowerStripes, borrower));
+    for (int j = 0; j < borrower->books_borrowed.size(); j++) {
+        if (borrower->books_borrowed[j] == book) {
+            borrower->books_borrowed.erase(j);
+            break;
         }
-    } else {
-        cerr << "Book cannot be found!" << endl;
     }
+    return true;
 }
 
 //Function to list all the current borrowers in the list of the specified book 
 void LCMS::listCurrentBorrowers(string bookTitle) {
-    //Create a node to start from the root of the tree
-    Node* root = libTree->getRoot();
     //Create a book object to find a book with specified title
-    Book* book = libTree->findBook(root, bookTitle);
+    ReadGuard guard(catalogLock);
+    Book* book = lookupBook(bookTitle);
     
     //If book is found, then
     if (book) {
         //Iterate through each borrower and print their names and ids 
+        std::lock_guard<std::mutex> bookGuard(stripeOf(bookStripes, book));
         for (int i = 0; i < book->currentBorrowers.size(); i++) {
             cout << i << " " << book->currentBorrowers[i]->name << " (ID: " << book->currentBorrowers[i]->id << ")" << endl;
         }
@@ -524,15 +1018,15 @@ void LCMS::listCurrentBorrowers(string bookTitle) {
 
 //Function to display all the borrowers including the past ones of the specified book 
 void LCMS::listAllBorrowers(string bookTitle) {
-    //Create a node to start from the root of the tree
-    Node* root = libTree->getRoot();
     //Create a book object to find a book with specified title
-    Book* book = libTree->findBook(root, bookTitle);
+    ReadGuard guard(catalogLock);
+    Book* book = lookupBook(bookTitle);
     
     //If book is found, then
     if (book) {
         cout << "All borrowers of " << bookTitle << ":" << endl;
         //Iterate through each borrower and display their names and ids 
+        std::lock_guard<std::mutex> bookGuard(stripeOf(bookStripes, book));
         for (int i = 0; i < book->allBorrowers.size(); i++) {
             cout << book->allBorrowers[i]->name << " (ID: " << book->allBorrowers[i]->id << ")" << endl;
         }
@@ -558,23 +1052,15 @@ void LCMS::listBooks(string borrower_name_id) {
 
     cout << "Books borrowed by " << name << " (ID: " << id << ") are listed below:" << endl;
 
-    //Initialize and set the flag to false
-    bool flag = false;
-    //Iterate through each borrower in the list 
-    for (int i = 0; i < borrowers.size(); i++) {
-        //if borrower's name and if mathces the user input, then
-        if (borrowers[i]->name == name && borrowers[i]->id == id) {
-            //List all the books that they borrowed
-            borrowers[i]->listBooks();
-            //Set the flag to be true to indicate that the specified borrower exists
-            flag = true;
-            //Exit the loop 
-            break;
-        }
-    }
-
-    //If the specified borrower does not exist, then display an error message 
-    if (!flag) {
+    //Look up the borrower in the registry
+    ReadGuard guard(catalogLock);
+    Borrower* borrower = borrowers.find(name, id);
+    //If the borrower exists, then list all the books that they borrowed
+    if (borrower) {
+        std::lock_guard<std::mutex> borrowerGuard(stripeOf(borrowerStripes, borrower));
+        borrower->listBooks(authorNames);
+    } else {
+        //If the specified borrower does not exist, then display an error message 
         cerr << "Borrower with name '" << name << "' and ID '" << id << "' cannot be found!" << endl;
     }
 }
@@ -582,70 +1068,25 @@ void LCMS::listBooks(string borrower_name_id) {
 
 //Function to remove the book from catalog 
 void LCMS::removeBook(string bookTitle) {
-    //Create a node called currentNode to start from the root of the tree
-    Node* currentNode = libTree->getRoot();
-
-    //Create a Book object called book to search for the specific book in the library tree
-    Book* book = libTree->findBook(currentNode, bookTitle);
+    //Search for the specific book in the title index
+    BookInfo info;
 
     //If book is found, 
-    if (book) {
+    if (getBook(bookTitle, info) == CATALOG_OK) {
         //Ask for confirmation
         string confirm;
         cout << "Are you sure you want to delete the book '" << bookTitle << "' from the catalog? (yes/no): ";
         getline(cin, confirm);
 
         //If user input is yes, then
-        if (confirm == "yes") {
-            //Initialize stack 
-            MyVector<Node*> stack;
-            //Add root node to the stack 
-            stack.push_back(currentNode);
-
-            //Initialize flag to false
-            bool flag = false;
-
-            //Create a while loop to locate and remove book
-            while (!stack.empty() && !flag) {
-                //Remove the last node from the stack 
-                Node* node = stack[stack.size() - 1];
-                stack.erase(stack.size() - 1);
-
-                //Use for loop to search for the book in the node's list of the books
-                for (int i = 0; i < node->books.size(); i++) {
-                    //If title matches then
-                    if (node->books[i]->title == bookTitle) {
-                        //Deelte the book object and remove it from the books vector as well
-                        delete node->books[i];
-                        node->books.erase(i);
-                        flag = true; //Set the flag to be true to indicate that the elimination of the book succeeded
-
-                        Node* parentNode = node;
-                        while (parentNode) {
-                            parentNode->bookCount--; //Decrement bookCount by one 
-                            parentNode = parentNode->parent; //Move to its parent node 
-                        }
-                        cout << "Book '" << bookTitle << "' has been removed from the catalog." << endl;
-                        break; //Exit the loop 
-                    }
-                }
-
-                //If the book was not found and removed from the node, then
-                if (!flag) {
-                    //Iterate through each child of the node to add them to the stack 
-                    for (int i = 0; i < node->children.size(); i++) {
-                        stack.push_back(node->children[i]);
-                    }
-                }
-            }
-
-            //If the book was not removed, then print out an error message 
-            if (!flag) {
-                cerr << "Failed to remove the book from the catalog." << endl;
-            }
-        } else {
+        if (confirm != "yes") {
             //If the user decides to calcel removing the book, then print out an message
             cout << "Book removal has been canceled." << endl;
+        } else if (deleteBook(bookTitle) == CATALOG_OK) {
+            cout << "Book '" << bookTitle << "' has been removed from the catalog." << endl;
+        } else {
+            //Another desk removed the book while waiting for the confirmation
+            cerr << "Book cannot be found!" << endl;
         }
     } else {
         //If the book was not found in the tree, then print out an error 
@@ -653,16 +1094,87 @@ void LCMS::removeBook(string bookTitle) {
     }
 }
 
+//Function to remove the book with the given title from the catalog and record it in the journal
+CatalogStatus LCMS::deleteBook(const string& title) {
+    STATS_START(timer, "api.deleteBook");
+    uint64_t seq;
+    {
+        WriteGuard guard(catalogLock);
+        Book* book = lookupBook(title);
+        if (!book) {
+            return CATALOG_NOT_FOUND;
+        }
+        eraseBook(book);
+        seq = queueChange(JOURNAL_REMOVE_BOOK, {title});
+    }
+    awaitChange(seq);
+    return CATALOG_OK;
+}
+
+//Function to take a book out of the catalog and deallocate it
+void LCMS::eraseBook(Book* book) {
+    //Take the book out of the category that holds it
+    Node* node = book->node;
+    for (int i = 0; i < node->books.size(); i++) {
+        if (node->books[i] == book) {
+            node->books.erase(i);
+            break;
+        }
+    }
+    //Decrement bookCount of the category and all its parents
+    libTree->updateBookCount(node, -1);
+    releaseBook(book);
+}
+
+//Function to deallocate a book that is no longer in the tree
+void LCMS::releaseBook(Book* book) {
+    //Remove the book from the title index
+    unindexBook(book, book->title);
+
+    //Remove the book from the list of every borrower currently holding it
+    for (int i = 0; i < book->currentBorrowers.size(); i++) {
+        Borrower* borrower = book->currentBorrowers[i];
+        for (int j = 0; j < borrower->books_borrowed.size(); j++) {
+            if (borrower->books_borrowed[j] == book) {
+                borrower->books_borrowed.erase(j);
+                break;
+            }
+        }
+    }
+    //Deallocate the book, making its slot available to the next new book
+    bookPool.destroy(book);
+}
+
 //Function to add category 
 void LCMS::addCategory(string category) {
     //Create a new cateogry node in the library tree
-    libTree->createNode(category);
+    createCategory(category);
     cout << "Category has been added!" << endl;
 }
 
+//Function to create a category (and any missing parent) and record it in the journal
+CatalogStatus LCMS::createCategory(const string& category) {
+    STATS_START(timer, "api.createCategory");
+    uint64_t seq;
+    {
+        WriteGuard guard(catalogLock);
+        libTree->createNode(category);
+        seq = queueChange(JOURNAL_ADD_CATEGORY, {category});
+    }
+    awaitChange(seq);
+    return CATALOG_OK;
+}
+
+//Function to check if a category exists
+bool LCMS::hasCategory(const string& category) {
+    ReadGuard guard(catalogLock);
+    return libTree->getNode(category) != nullptr;
+}
+
 //Function to find the specified category 
 void LCMS::findCategory(string category) {
     //Use getNode to find the node corresponding to the full path
+    ReadGuard guard(catalogLock);
     Node* categoryNode = libTree->getNode(category);
 
     //If categoryNode is found, then display message saying that
@@ -673,44 +1185,59 @@ void LCMS::findCategory(string category) {
     }
 }
 
-//Function to remove the specified category 
-void LCMS::removeCategory(string category) {
-    //Create a node called categoryNode for the specified category 
-    Node* categoryNode = libTree->getNode(category);
-
-    //If the category node was found and it has a parent, then
-    if (categoryNode && categoryNode->parent) {
-        //Declare booksRemove to count the number of books in the category
-        int booksRemove = categoryNode->books.size();  
+//Function to summarize the books of a category ("<category>[|<from year>|<to year>]")
+void LCMS::summary(string parameter) {
+    STATS_START(timer, "summary");
+    //Split the parameter into the category and the optional range of publication years
+    stringstream sstr(parameter);
+    string category, from, to;
+    getline(sstr, category, '|');
+    getline(sstr, from, '|');
+    getline(sstr, to);
+    int fromYear = INT_MIN, toYear = INT_MAX;
+    try {
+        if (!from.empty()) fromYear = std::stoi(from);
+        if (!to.empty()) toYear = std::stoi(to);
+    } catch (const std::exception&) {
+        cerr << "Invalid range of publication years!" << endl;
+        return;
+    }
 
-        //Create a stack to hold nodes
-        MyVector<Node*> nodes_stack;
-        //use push_back function to initialize the stack with the categoryNode
-        nodes_stack.push_back(categoryNode);
-        
-        //Loop until stack is empty
-        while (!nodes_stack.empty()) {
-            //Get the node from the stack 
-            Node* currentNode = nodes_stack.back();
-            //Remove the last node of the stack 
-            nodes_stack.erase(nodes_stack.size() - 1);
-            
-            //Add the book count of the node to booksRemove
-            booksRemove += currentNode->books.size();
-
-            //Iterate through each child to add them into the stack by using push_back function 
-            for (int i = 0; i < currentNode->children.size(); i++) {
-                nodes_stack.push_back(currentNode->children[i]);
-            }
-        }
+    //Find the category; an empty category summarizes the whole library
+    //(circulation desks may update available copies during the scan, so the counts are a snapshot of a moving catalog)
+    ReadGuard guard(catalogLock);
+    Node* categoryNode = libTree->getNode(category);
+    if (!categoryNode) {
+        cerr << "Category is not found!" << endl;
+        return;
+    }
 
-        //Update the book count in the parent node
-        libTree->updateBookCount(categoryNode->parent, -booksRemove);
+    //Mark the category and its sub-categories, then scan the book columns once
+    MyVector<unsigned char> selected(libTree->nodeIdLimit());
+    for (unsigned int i = 0; i < libTree->nodeIdLimit(); i++) {
+        selected.push_back(0);
+    }
+    libTree->markSubtree(categoryNode, selected);
+    ColumnSummary result = columns.summarize(selected, fromYear, toYear);
+
+    //Display the aggregates
+    cout << "Category: " << categoryNode->getCategory(categoryNode) << endl;
+    cout << "Books: " << result.books << endl;
+    cout << "Total copies: " << result.totalCopies << endl;
+    cout << "Available copies: " << result.availableCopies << endl;
+    cout << "Copies on loan: " << result.totalCopies - result.availableCopies << endl;
+    cout << "Books with no available copies: " << result.unavailableBooks << endl;
+    if (result.books > 0) {
+        cout << "Publication years: " << result.minYear << " - " << result.maxYear << endl;
+    }
+}
 
-        //Remove the category ndoe by calling the remove function 
-        libTree->remove(categoryNode->parent, categoryNode->name);
+//Function to remove the specified category 
+void LCMS::removeCategory(string category) {
+    CatalogStatus status = deleteCategory(category);
+    if (status == CATALOG_OK) {
         cout << "Category '" << category << "' removed!" << endl;
-    } else if (!categoryNode) {
+    } else if (status == CATALOG_NOT_FOUND) {
         //If the category node was not found, then display an error message
         cerr << "Category '" << category << "' not found!" << endl;
     } else {
@@ -719,36 +1246,390 @@ void LCMS::removeCategory(string category) {
     }
 }
 
+//Function to remove a category with its sub-categories and books and record it in the journal
+CatalogStatus LCMS::deleteCategory(const string& category) {
+    STATS_START(timer, "api.deleteCategory");
+    TraceSpan span("removeCategory");
+    span.arg("category", category);
+    uint64_t seq;
+    {
+        //Create a node called categoryNode for the specified category 
+        WriteGuard guard(catalogLock);
+        Node* categoryNode = libTree->getNode(category);
+        if (!categoryNode) {
+            return CATALOG_NOT_FOUND;
+        } else if (!categoryNode->parent) {
+            return CATALOG_ROOT_CATEGORY;
+        }
+        //The category node was found and it has a parent, so remove it
+        eraseCategory(categoryNode);
+        seq = queueChange(JOURNAL_REMOVE_CATEGORY, {category});
+    }
+    awaitChange(seq);
+    return CATALOG_OK;
+}
+
+//Function to remove a category (other than the root) with its sub-categories
+void LCMS::eraseCategory(Node* categoryNode) {
+    //Create a vector to collect every book of the category and its sub-categories
+    TraceSpan collectSpan("removeCategory.collect");
+    MyVector<Book*> removedBooks(categoryNode->bookCount);
+
+    //Walk the category itself instead of the tree layout: after a change to the tree the layout would be rebuilt
+    //for every node of the catalog, while this walk only visits the removed sub-categories
+    //Create a stack to hold nodes
+    MyVector<Node*> nodes_stack;
+    //use push_back function to initialize the stack with the categoryNode
+    nodes_stack.push_back(categoryNode);
+    
+    //Loop until stack is empty
+    while (!nodes_stack.empty()) {
+        //Get the node from the stack 
+        Node* currentNode = nodes_stack.back();
+        //Remove the last node of the stack 
+        nodes_stack.pop_back();
+        
+        //Collect the books of the node
+        for (int i = 0; i < currentNode->books.size(); i++) {
+            removedBooks.push_back(currentNode->books[i]);
+        }
+
+        //Iterate through each child to add them into the stack by using push_back function 
+        for (int i = 0; i < currentNode->children.size(); i++) {
+            nodes_stack.push_back(currentNode->children[i]);
+        }
+    }
+
+    collectSpan.arg("books", removedBooks.size());
+    collectSpan.end();
+
+    //Update the book count in the parent node
+    TraceSpan countSpan("removeCategory.bookCounts");
+    libTree->updateBookCount(categoryNode->parent, -(int)categoryNode->bookCount);
+    countSpan.end();
+
+    //Remove the category ndoe by calling the remove function 
+    TraceSpan unlinkSpan("removeCategory.unlink");
+    libTree->remove(categoryNode->parent, categoryNode->name);
+    unlinkSpan.end();
+
+    //Deallocate the books of the deleted categories once they are out of the tree
+    TraceSpan releaseSpan("removeCategory.release");
+    for (int i = 0; i < removedBooks.size(); i++) {
+        releaseBook(removedBooks[i]);
+    }
+}
+
+//Function to rename a category and record it in the journal
+CatalogStatus LCMS::moveCategory(const string& category, const string& newCategory) {
+    STATS_START(timer, "api.moveCategory");
+    uint64_t seq;
+    {
+        WriteGuard guard(catalogLock);
+        Node* categoryNode = libTree->getNode(category);
+        if (!categoryNode) {
+            return CATALOG_NOT_FOUND;
+        } else if (!categoryNode->parent) {
+            return CATALOG_ROOT_CATEGORY;
+        }
+        if (!relocateCategory(categoryNode, newCategory)) {
+            return CATALOG_INVALID_ARGUMENT;
+        }
+        seq = queueChange(JOURNAL_EDIT_CATEGORY, {category, newCategory});
+    }
+    awaitChange(seq);
+    return CATALOG_OK;
+}
+
+//Function to move the books and sub-categories of a category (other than the root) to a new path and remove the category
+bool LCMS::relocateCategory(Node* categoryNode, const string& newCategory) {
+    //The new path cannot be the category or one of its sub-categories, since they are removed at the end
+    Node* root = libTree->getRoot();
+    string target = root->getCategory(root) + "/" + newCategory;
+    const string& source = categoryNode->getCategory(categoryNode);
+    if (target.compare(0, source.size(), source) == 0 && (target.size() == source.size() || target[source.size()] == '/')) {
+        return false;
+    }
+
+    //Collect the category and its sub-categories before new categories are added to the tree
+    MyVector<Node*> moved;
+    MyVector<Node*> nodes_stack;
+    nodes_stack.push_back(categoryNode);
+    while (!nodes_stack.empty()) {
+        Node* currentNode = nodes_stack.back();
+        nodes_stack.pop_back();
+        moved.push_back(currentNode);
+        //Push the children last to first, so every category is created before its sub-categories
+        for (int i = currentNode->children.size() - 1; i >= 0; i--) {
+            nodes_stack.push_back(currentNode->children[i]);
+        }
+    }
+
+    //Move the books of every category to the same path below the new category
+    for (int n = 0; n < moved.size(); n++) {
+        Node* oldNode = moved[n];
+        const string& path = oldNode->getCategory(oldNode);
+        Node* newNode = libTree->createNode(oldNode == categoryNode ? newCategory : newCategory + path.substr(source.size()));
+        for (int i = 0; i < oldNode->books.size(); i++) {
+            Book* book = oldNode->books[i];
+            newNode->books.push_back(book);
+            book->node = newNode;
+            refreshBook(book);
+        }
+        libTree->updateBookCount(newNode, oldNode->books.size());
+        oldNode->books.clear();
+    }
+
+    //The old categories no longer hold books: take their count off the old path and remove them
+    libTree->updateBookCount(categoryNode->parent, -(int)categoryNode->bookCount);
+    libTree->remove(categoryNode->parent, categoryNode->name);
+    return true;
+}
 
 //Function to edit the specified category 
 void LCMS::editCategory(string category) {
-    //Create a node for the specified category 
-    Node* oldCategoryNode = libTree->getNode(category);
+    //Check that the specified category exists
+    bool found;
+    {
+        ReadGuard guard(catalogLock);
+        found = libTree->getNode(category) != nullptr;
+    }
     //If the category node was found, then
-    if (oldCategoryNode) {
+    if (found) {
         //Ask user input for a new category name 
         string newCategory;
         cout << "Enter new category name: ";
         getline(cin, newCategory);
 
-        //Create a node called newCategoryNode with the updated name 
-        Node* newCategoryNode = libTree->createNode(newCategory);
+        //Move the category (it is found again, since another desk may have removed it while waiting for the user)
+        CatalogStatus status = moveCategory(category, newCategory);
+        if (status == CATALOG_OK) {
+            cout << "Category is now updated to " << newCategory << "!" << endl;
+        } else if (status == CATALOG_NOT_FOUND) {
+            cerr << "Category cannot be found!" << endl;
+        } else if (status == CATALOG_ROOT_CATEGORY) {
+            cerr << "Cannot edit the root category!" << endl;
+        } else {
+            cerr << "A category cannot be moved into itself or one of its sub-categories!" << endl;
+        }
+    } else {
+        //If category cannot be found, then display an error message 
+        cerr << "Category cannot be found!" << endl;
+    }
+}
 
-        //For loop to move all the books from the old category to new one
-        for (int i = 0; i < oldCategoryNode->books.size(); i++) {
-            //Create a book object to get each book from the old category 
-            Book* book = oldCategoryNode->books[i];
-            //Add the book to the new category 
-            newCategoryNode->books.push_back(book);
+//Function to handle the journal command ("open <file>" or "close")
+void LCMS::journal(string parameter) {
+    stringstream sstr(parameter);
+    string action, path;
+    getline(sstr, action, ' ');
+    getline(sstr, path);
+
+    if (action == "open" && !path.empty()) {
+        openJournal(path);
+    } else if (action == "recover" && !path.empty()) {
+        //"recover <snapshot>|<journal>" restores the catalog after a restart
+        size_t bar = path.find('|');
+        if (bar == string::npos || bar == 0 || bar + 1 == path.size()) {
+            cerr << "Usage: journal recover <snapshot file>|<journal file>" << endl;
+            return;
         }
+        recover(path.substr(0, bar), path.substr(bar + 1));
+    } else if (action == "close") {
+        //Circulation queues changes while holding the catalog as a reader, so closing waits for the desks to finish
+        WriteGuard guard(catalogLock);
+        changeLog.close();
+        cout << "Journal has been closed." << endl;
+    } else {
+        cerr << "Usage: journal open <file> | journal recover <snapshot file>|<journal file> | journal close" << endl;
+    }
+}
 
+//Function to open a journal, replay the changes it holds on top of the current catalog and record further changes in it
+bool LCMS::openJournal(string path) {
+    WriteGuard guard(catalogLock);
+    std::vector<JournalRecord> records;
+    if (!changeLog.open(path, records)) {
+        cerr << "We can't open the journal, which is " << path << endl;
+        return false;
+    }
+    int replayed = 0;
+    for (size_t i = 0; i < records.size(); i++) {
+        if (replay(records[i])) replayed++;
+    }
+    cout << replayed << " of " << records.size() << " journal records have been replayed from: " << path << endl;
+    return true;
+}
 
-        //Remove the old category by calling remove function 
-        libTree->remove(oldCategoryNode, category);
+//Function to restore the catalog after a restart: load the last snapshot, replay the journal (which holds the changes
+//made since that snapshot) and keep the journal open for further changes. A missing snapshot means none was saved yet
+bool LCMS::recover(string snapshotPath, string journalPath) {
+    if (changeLog.isOpen()) {
+        cerr << "Close the journal before recovering the catalog!" << endl;
+        return false;
+    }
+    if (ifstream(snapshotPath).good() && !loadSnapshot(snapshotPath)) {
+        return false;
+    }
+    return openJournal(journalPath);
+}
 
-        cout << "Category is now updated to " << newCategory << "!" << endl;
+//Function to handle the stats command ("", "reset", "dump <file> [seconds]" or "dump off")
+void LCMS::stats(string parameter) {
+#ifdef LCMS_STATS
+    stringstream sstr(parameter);
+    string action, path, seconds;
+    getline(sstr, action, ' ');
+    getline(sstr, path, ' ');
+    getline(sstr, seconds);
+
+    if (action.empty()) {
+        Stats::instance().print(cout);
+    } else if (action == "reset") {
+        Stats::instance().reset();
+        cout << "Statistics have been reset." << endl;
+    } else if (action == "dump" && path == "off") {
+        Stats::instance().stopDump();
+        cout << "Statistics are no longer dumped." << endl;
+    } else if (action == "dump" && !path.empty()) {
+        int interval = 60;
+        try {
+            if (!seconds.empty()) interval = std::stoi(seconds);
+        } catch (const std::exception&) {
+            interval = 0;
+        }
+        if (!Stats::instance().startDump(path, interval)) {
+            cerr << "We can't dump the statistics every " << seconds << " seconds to " << path << endl;
+            return;
+        }
+        cout << "Statistics are appended to " << path << " every " << interval << " seconds." << endl;
     } else {
-        //If category cannot be found, then display an error message 
-        cerr << "Category cannot be found!" << endl;
+        cerr << "Usage: stats | stats reset | stats dump <file> [seconds] | stats dump off" << endl;
+    }
+#else
+    (void)parameter;
+    cerr << "Statistics are not compiled into this build (build with STATS=1)." << endl;
+#endif
+}
+
+//Function to handle the trace command ("start <file>" or "stop")
+void LCMS::trace(string parameter) {
+    stringstream sstr(parameter);
+    string action, path;
+    getline(sstr, action, ' ');
+    getline(sstr, path);
+
+    if (action == "start" && !path.empty()) {
+        //Spans of import, export, findAll and removeCategory are recorded until trace stop
+        if (!TraceLog::instance().start(path)) {
+            cerr << "We can't write the trace, which is " << path << endl;
+            return;
+        }
+        cout << "Tracing to: " << path << endl;
+    } else if (action == "stop") {
+        if (!TraceLog::enabled()) {
+            cerr << "No trace is being recorded." << endl;
+        } else if (TraceLog::instance().stop()) {
+            cout << "Trace has been written." << endl;
+        } else {
+            cerr << "Failed to write the trace!" << endl;
+        }
+    } else {
+        cerr << "Usage: trace start <file> | trace stop" << endl;
+    }
+}
+
+//Function to record a change in the journal, if one is open
+void LCMS::logChange(JournalOp op, const std::vector<string>& args) {
+    awaitChange(queueChange(op, args));
+}
+
+//Function to append a change to the journal without waiting for the disk
+uint64_t LCMS::queueChange(JournalOp op, const std::vector<string>& args) {
+    if (!changeLog.isOpen()) {
+        return 0;
+    }
+    JournalRecord record = {op, args};
+    return changeLog.append(record);
+}
+
+//Function to wait until a queued change is on disk
+void LCMS::awaitChange(uint64_t seq) {
+    //Changes committed at the same time share one fsync
+    if (seq == 0) {
+        return;
+    }
+    STATS_START(timer, "journal.wait");
+    TraceSpan span("journal.wait");
+    if (!changeLog.waitDurable(seq)) {
+        cerr << "Warning: the change could not be written to the journal!" << endl;
+    }
+}
+
+//Function to apply a journal record to the catalog, return false if it no longer applies
+bool LCMS::replay(const JournalRecord& record) {
+    const std::vector<string>& args = record.args;
+    try {
+        switch (record.op) {
+            case JOURNAL_ADD_BOOK: {
+                if (args.size() != 7) return false;
+                //The catalog may already hold the book (e.g. imported again or loaded from a snapshot): ISBN is its
+                //unique key as in addBook, and a book without a valid ISBN is matched by title and ISBN text
+                unsigned long long isbnKey;
+                if (normalizeIsbn(args[2], isbnKey)) {
+                    if (lookupIsbn(isbnKey)) return false;
+                } else {
+                    for (Book* book = lookupBook(args[0]); book; book = book->nextSameTitle) {
+                        if (book->isbn == args[2]) return false;
+                    }
+                }
+                insertBook(args[0], args[1], args[2], std::stoi(args[3]), std::stoi(args[4]), std::stoi(args[5]), args[6]);
+                return true;
+            }
+            case JOURNAL_EDIT_BOOK: {
+                if (args.size() != 3) return false;
+                Book* book = lookupBook(args[0]);
+                return book && setBookField(book, std::stoi(args[1]), args[2]);
+            }
+            case JOURNAL_REMOVE_BOOK: {
+                if (args.size() != 1) return false;
+                Book* book = lookupBook(args[0]);
+                if (!book) return false;
+                eraseBook(book);
+                return true;
+            }
+            case JOURNAL_BORROW_BOOK: {
+                if (args.size() != 3) return false;
+                Book* book = lookupBook(args[0]);
+                if (!book || book->available_copies <= 0) return false;
+                lendBook(book, args[1], args[2]);
+                return true;
+            }
+            case JOURNAL_RETURN_BOOK: {
+                if (args.size() != 3) return false;
+                Book* book = lookupBook(args[0]);
+                return book && takeBackBook(book, args[1], args[2]);
+            }
+            case JOURNAL_ADD_CATEGORY:
+                if (args.size() != 1) return false;
+                libTree->createNode(args[0]);
+                return true;
+            case JOURNAL_REMOVE_CATEGORY: {
+                if (args.size() != 1) return false;
+                Node* categoryNode = libTree->getNode(args[0]);
+                if (!categoryNode || !categoryNode->parent) return false;
+                eraseCategory(categoryNode);
+                return true;
+            }
+            case JOURNAL_EDIT_CATEGORY: {
+                if (args.size() != 2) return false;
+                Node* categoryNode = libTree->getNode(args[0]);
+                if (!categoryNode || !categoryNode->parent) return false;
+                return relocateCategory(categoryNode, args[1]);
+            }
+        }
+    } catch (const std::exception&) {
+        //A number that cannot be converted makes the record invalid
     }
+    return false;
 }
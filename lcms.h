@@ -9,24 +9,146 @@
 #ifndef _LCMS_H
 #define _LCMS_H
 #include<string>
+#include <mutex>
 #include "tree.h"
 #include "myvector.h"
+#include "myhashmap.h"
+#include "objectpool.h"
 #include "borrower.h"
+#include "borrowerregistry.h"
+#include "journal.h"
+#include "bookcolumns.h"
+#include "titlesearch.h"
+#include "authorindex.h"
+#include "yearindex.h"
+#include "rwlock.h"
 //#include "book.h"
 
+//Entry of the title index: the books with a title, linked through Book::nextSameTitle in the order they were added
+//(the first one is the one found)
+struct TitleEntry
+{
+	Book* first;
+	Book* last;
+};
+
+//Outcome of a call of the programmatic API
+enum CatalogStatus
+{
+	CATALOG_OK,						//the change was made (or the book was found)
+	CATALOG_NOT_FOUND,				//no book with that title, or no such category
+	CATALOG_NO_COPIES,				//borrowBook: every copy is on loan
+	CATALOG_NOT_BORROWER,			//returnBook: the borrower does not hold a copy of the book
+	CATALOG_DUPLICATE_ISBN,			//another book already has the ISBN
+	CATALOG_INVALID_ARGUMENT,		//empty or unchanged value, or a number that cannot be parsed
+	CATALOG_ROOT_CATEGORY			//the root category cannot be removed
+};
+const char* statusMessage(CatalogStatus status);	//Return a short description of a status for messages
+
+//Fields of a book that editBook can change (numbered as in the edit menu and the journal)
+enum BookField
+{
+	BOOK_TITLE = 1,
+	BOOK_AUTHOR = 2,
+	BOOK_ISBN = 3,
+	BOOK_PUBLICATION_YEAR = 4,
+	BOOK_TOTAL_COPIES = 5,
+	BOOK_AVAILABLE_COPIES = 6
+};
+
+//Details of a book passed to and returned by the programmatic API
+struct BookInfo
+{
+	string title;
+	string author;
+	string isbn;
+	int publicationYear;
+	int totalCopies;
+	int availableCopies;
+	string category;				//full path of the category, e.g. "Fiction/Classics"
+};
+
+//Concurrency: every command holds catalogLock, as a reader if it leaves the catalog unchanged and as the
+//writer otherwise. Circulation (borrowBook/returnBook) only changes loans and copies, so it holds catalogLock
+//as a reader and serializes on the stripe of the book (and then of the borrower) it changes; desks working on
+//different books do not wait for each other. available_copies is atomic so readers need no stripe to see it.
 class LCMS
 {
 	private:
+		static const int LOCK_STRIPES = 64;	//number of book stripes and of borrower stripes
+
+		RwLock catalogLock; //readers: queries and circulation, writer: every other change
+		std::mutex bookStripes[LOCK_STRIPES]; //guard the loan lists of the books hashed to them
+		std::mutex borrowerStripes[LOCK_STRIPES]; //guard the loan lists of the borrowers hashed to them
 		Tree *libTree;	//Tree of Categories and books
-		MyVector<Borrower*> borrowers; //list of borrowers that have ever borrowed a book	
+		ObjectPool<Book> bookPool; //storage of every book in the catalog (categories only point to them)
+		BorrowerRegistry borrowers; //borrowers that have ever borrowed a book, indexed by (name, id) and id
+		MyHashMap<string, TitleEntry> titleIndex; //title -> book (its category is book->node)
+		Journal changeLog; //write-ahead journal of catalog changes (see journal command)
+		BookColumns columns; //year, copies and category of every book in contiguous arrays (see summary command)
+		TitleSearchIndex titleSearch; //trigrams of the titles for substring search (see searchTitle command)
+		StringPool authorNames; //every distinct author name of the catalog, stored once for all its books
+		AuthorIndex authorIndex; //normalized author -> books (see findByAuthor command)
+		YearIndex yearIndex; //books ordered by publication year (see findByYear command)
+		MyHashMap<unsigned long long, Book*> isbnIndex; //normalized ISBN-13 -> book (see findByIsbn command)
+
+		Book* lookupBook(const string& title);	//find a book by title in O(1), nullptr if not found
+		Book* lookupIsbn(unsigned long long key);	//find a book by normalized ISBN in O(1), nullptr if not found
+		void attachBook(Node* node, Book* book);	//append a book to a category and index it (book counts are left to the caller)
+		void indexBook(Book* book);				//add a book to the title, title search, author, year and ISBN indexes and the book columns
+		void unindexBook(Book* book, const string& title);	//remove a book indexed under title from every index
+		void refreshBook(Book* book);			//bring the indexes up to date after the fields or category of a book changed
+		void indexIsbn(Book* book);				//normalize the ISBN of a book and add it to the ISBN index unless another book has it
+		void unindexIsbn(Book* book);			//remove a book from the ISBN index
+		void clearCatalog();					//delete the tree, every book and every borrower
+		void describeBook(Book* book, BookInfo& info);	//copy the details of a book into info
+		static std::mutex& stripeOf(std::mutex* stripes, const void* object);	//return the stripe that guards an object
+
+		//Changes shared by the commands and journal replay (no console input/output)
+		Book* insertBook(const string& title, const string& author, const string& isbn, int publicationYear, int totalCopies, int availableCopies, const string& category);
+		bool setBookField(Book* book, int field, const string& value);	//field is numbered as in the editBook menu
+		//Circulation may run on several desks at once (catalogLock held as a reader). If journalSeq is given, the change is
+		//queued in the journal while the book is locked, so the journal has the changes of a book in the order they happened
+		bool lendBook(Book* book, const string& name, const string& id, uint64_t* journalSeq = nullptr);	//return false if no copy is available
+		bool takeBackBook(Book* book, const string& name, const string& id, uint64_t* journalSeq = nullptr);
+		void eraseBook(Book* book);
+		void releaseBook(Book* book);			//unindex a book that is out of the tree, drop it from its borrowers and deallocate it
+		void eraseCategory(Node* categoryNode);
+		bool relocateCategory(Node* categoryNode, const string& newCategory);	//move books and sub-categories to newCategory, remove the category
+		void logChange(JournalOp op, const std::vector<string>& args);	//append a change to the journal and wait until it is on disk
+		uint64_t queueChange(JournalOp op, const std::vector<string>& args);	//append a change to the journal, return its sequence number (0 if no journal is open)
+		void awaitChange(uint64_t seq);			//wait until a queued change is on disk
+		bool replay(const JournalRecord& record);	//apply a journal record, return false if it no longer applies
 	public:
 		LCMS(string name);
 		~LCMS();
 
+		//Programmatic API: parameters in, status out, no console input/output. Each call takes the locks it needs
+		//and returns once its change is in the journal (if one is open), so it can be called from several threads
+		CatalogStatus addBook(const BookInfo& info);	//add a book, creating its category if needed
+		CatalogStatus editBook(const string& title, BookField field, const string& value);	//change one field of a book
+		CatalogStatus borrowBook(const string& title, const string& name, const string& id);	//issue a copy to a borrower
+		CatalogStatus returnBook(const string& title, const string& name, const string& id);	//take a copy back from a borrower
+		CatalogStatus deleteBook(const string& title);	//remove a book from the catalog
+		CatalogStatus createCategory(const string& category);	//add a category (and any missing parents)
+		CatalogStatus deleteCategory(const string& category);	//remove a category with its sub-categories and books
+		CatalogStatus moveCategory(const string& category, const string& newCategory);	//rename a category: its books and sub-categories move to newCategory
+		CatalogStatus getBook(const string& title, BookInfo& info);	//fill info with the details of a book
+		CatalogStatus getBookByIsbn(const string& isbn, BookInfo& info);	//same, for the book with an ISBN-10 or ISBN-13
+		bool hasCategory(const string& category);	//return true if the category exists
+		CatalogStatus getBorrowerCount(const string& title, int& count);	//set count to the number of current borrowers of a book
+		int getLoanCount(const string& name, const string& id);	//return the number of books a borrower holds (0 if not registered)
+
+		//Console commands: read follow-up input from cin and print the outcome (thin wrappers around the API above)
+
 		int import(string path); //import books from a csv file
 		void exportData(string path); //export all books to a given file
 		void findAll(string category); //display all books of a category
 		void findBook(string bookTitle); //Find a given book and display its details
+		void searchTitle(string fragment); //list the books whose title contains fragment, best matches first
+		void findByIsbn(string isbn); //find a book by its ISBN-10 or ISBN-13 and display its details
+		void findByAuthor(string parameter); //"<author>[|<category>]" display the books of an author, optionally within a category
+		void findByYear(string parameter); //"<from> <to> [category]" display the books published in a range of years, optionally within a category
 		void addBook();	//add a book to the catalog
 		void editBook(string bookTitle); //edit a book
 		void borrowBook(string bookTitle); //borrow a book
@@ -39,8 +161,18 @@ class LCMS
 		void findCategory(string category); //find a category in the catalog
 		void removeCategory(string category); //remove a category from the catalog
 		void editCategory(string category); //edit a category from the catalog
+		void snapshot(string parameter); //"save <file>" or "load <file>" a binary snapshot of the catalog
+		bool saveSnapshot(string path); //write categories, books, borrowers and loans to a snapshot file
+		bool loadSnapshot(string path); //replace the catalog with the contents of a snapshot file
+		void journal(string parameter); //"open <file>" replays a journal and records further changes in it, "recover <snapshot>|<journal>", "close" stops recording
+		bool openJournal(string path); //replay a journal on top of the catalog and record further changes in it
+		bool recover(string snapshotPath, string journalPath); //load a snapshot (if saved), then replay and reopen the journal written after it
+		void summary(string parameter); //"<category>[|<from year>|<to year>]" aggregate copies and years of the books of a category
+		void stats(string parameter); //"" show command latencies, "reset", "dump <file> [seconds]" append them to a file periodically, "dump off"
+		void trace(string parameter); //"start <file>" records the phases of long commands as a Chrome trace, "stop" writes it
 		void list()				   //display the catalog in tree format by calling the print method of the libTree
 		{
+			ReadGuard guard(catalogLock);
 			libTree->print();
 		}
 };
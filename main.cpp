@@ -8,17 +8,44 @@
 //============================================================================
 #include<iostream>
 #include <sstream>
+#include <fstream>
 #include <string>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
 #include "lcms.h"
+#include "myhashmap.h"
+#include "myvector.h"
+#include "stats.h"
 using namespace std;
 
+//Number of runs and total time of one command in batch mode
+struct CommandTiming
+{
+	int count;
+	long long nanoseconds;
+};
+
 //Call listCommands to display the available commands for user 
 void listCommands();
+bool runCommand(LCMS& lcms, const string& command, const string& parameter);
+bool runBatchCommand(LCMS& lcms, const string& command, const string& parameter);
+int runBatch(LCMS& lcms, const char* path);
 
-int main()
+int main(int argc, char* argv[])
 {
 	//Initialize the program with the name "Library"
 	LCMS lcms("Library");
+
+	//"lcms --batch <file>" runs the commands of the file without prompts
+	if (argc == 3 && strcmp(argv[1], "--batch") == 0) {
+		return runBatch(lcms, argv[2]);
+	} else if (argc != 1) {
+		cerr << "Usage: " << argv[0] << " [--batch <file>]" << endl;
+		return EXIT_FAILURE;
+	}
+
 	listCommands();
 	//Declare string variables for user input 
 	string user_input; 
@@ -35,30 +62,15 @@ int main()
 			
 			// parse user-input into command and parameter(s)
 			stringstream sstr(user_input);
+			parameter.clear(); //a command without parameters must not see the previous one
 			getline(sstr,command,' ');
 			getline(sstr,parameter);
 	
 			
 			//add code as necessary
-			     if(command=="import") 			lcms.import(parameter); 
-			else if(command=="export")    	    lcms.exportData(parameter);
-			else if(command=="list")			lcms.list();
-			else if(command=="findAll")     	lcms.findAll(parameter);
-			else if(command=="findBook")		lcms.findBook(parameter);
-			else if(command=="addBook") 		lcms.addBook();
-			else if(command=="editBook")		lcms.editBook(parameter);
-			else if(command=="borrowBook")      lcms.borrowBook(parameter);
-			else if(command=="returnBook")      lcms.returnBook(parameter);
-			else if(command=="removeBook")      lcms.removeBook(parameter);
-			else if(command=="listCurrentBorrowers")  lcms.listCurrentBorrowers(parameter);
-			else if(command=="listAllBorrowers")  lcms.listAllBorrowers(parameter);
-			else if(command=="listBooks")       lcms.listBooks(parameter);
-			else if(command=="findCategory")    lcms.findCategory(parameter);
-			else if(command=="addCategory")    lcms.addCategory(parameter);
-			else if(command=="removeCategory")  lcms.removeCategory(parameter);
-			else if(command == "help")			listCommands();
+			     if(command == "help")			listCommands();
 			else if(command == "exit")			break;
-			else 								cout<<"Invalid Command!"<<endl;
+			else if(!runCommand(lcms, command, parameter))	cout<<"Invalid Command!"<<endl;
 			fflush(stdin);
 		}
 		catch(exception &ex)
@@ -69,6 +81,193 @@ int main()
 
 	return EXIT_SUCCESS;
 }
+#ifdef LCMS_STATS
+//Function to return the latency histogram of a command, looking it up in the registry only the first time
+//(commands run on the main thread only, so the cache needs no lock)
+LatencyHistogram* commandHistogram(const string& command)
+{
+	static MyHashMap<string, LatencyHistogram*> histograms;
+	LatencyHistogram** found = histograms.find(command);
+	if (found) {
+		return *found;
+	}
+	LatencyHistogram* histogram = Stats::instance().histogram("command." + command);
+	histograms.insert(command, histogram);
+	return histogram;
+}
+#endif
+//Function to run a command of the console, return false if the command is unknown
+bool runCommand(LCMS& lcms, const string& command, const string& parameter)
+{
+#ifdef LCMS_STATS
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+#endif
+	     if(command=="import") 			lcms.import(parameter); 
+	else if(command=="export")    	    lcms.exportData(parameter);
+	else if(command=="list")			lcms.list();
+	else if(command=="findAll")     	lcms.findAll(parameter);
+	else if(command=="findBook")		lcms.findBook(parameter);
+	else if(command=="searchTitle")     lcms.searchTitle(parameter);
+	else if(command=="findByIsbn")      lcms.findByIsbn(parameter);
+	else if(command=="findByAuthor")    lcms.findByAuthor(parameter);
+	else if(command=="findByYear")      lcms.findByYear(parameter);
+	else if(command=="addBook") 		lcms.addBook();
+	else if(command=="editBook")		lcms.editBook(parameter);
+	else if(command=="borrowBook")      lcms.borrowBook(parameter);
+	else if(command=="returnBook")      lcms.returnBook(parameter);
+	else if(command=="removeBook")      lcms.removeBook(parameter);
+	else if(command=="listCurrentBorrowers")  lcms.listCurrentBorrowers(parameter);
+	else if(command=="listAllBorrowers")  lcms.listAllBorrowers(parameter);
+	else if(command=="listBooks")       lcms.listBooks(parameter);
+	else if(command=="findCategory")    lcms.findCategory(parameter);
+	else if(command=="addCategory")    lcms.addCategory(parameter);
+	else if(command=="removeCategory")  lcms.removeCategory(parameter);
+	else if(command=="snapshot")        lcms.snapshot(parameter);
+	else if(command=="journal")         lcms.journal(parameter);
+	else if(command=="summary")         lcms.summary(parameter);
+	else if(command=="stats")           lcms.stats(parameter);
+	else if(command=="trace")           lcms.trace(parameter);
+	else								return false;
+#ifdef LCMS_STATS
+	//Record the latency of every known command under its name
+	commandHistogram(command)->record(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+#endif
+	return true;
+}
+//Function to split the parameter of a batch command into its '|'-separated arguments
+vector<string> splitArguments(const string& parameter)
+{
+	vector<string> args;
+	stringstream sstr(parameter);
+	string arg;
+	while (getline(sstr, arg, '|')) {
+		args.push_back(arg);
+	}
+	return args;
+}
+//Function to print the message of a successful change, or why the change was not made
+void reportStatus(CatalogStatus status, const string& success)
+{
+	if (status == CATALOG_OK) {
+		cout << success << endl;
+	} else {
+		cerr << statusMessage(status) << endl;
+	}
+}
+//Function to run a command of a batch file; the commands that prompt in the console take all their input from the parameter
+bool runBatchCommand(LCMS& lcms, const string& command, const string& parameter)
+{
+	vector<string> args = splitArguments(parameter);
+	if (command == "addBook") {
+		if (args.size() != 7) {
+			cerr << "Usage: addBook <title>|<author>|<isbn>|<year>|<category>|<total copies>|<available copies>" << endl;
+			return true;
+		}
+		BookInfo info = {args[0], args[1], args[2], stoi(args[3]), stoi(args[5]), stoi(args[6]), args[4]};
+		reportStatus(lcms.addBook(info), args[0] + " has been successfully added to the catalog.");
+	} else if (command == "editBook") {
+		int field = args.size() == 3 ? stoi(args[1]) : 0;
+		if (field < BOOK_TITLE || field > BOOK_AVAILABLE_COPIES) {
+			cerr << "Usage: editBook <title>|<field 1-6>|<new value>" << endl;
+			return true;
+		}
+		reportStatus(lcms.editBook(args[0], (BookField)field, args[2]), "Book '" + args[0] + "' has been updated.");
+	} else if (command == "borrowBook" || command == "returnBook") {
+		if (args.size() != 3) {
+			cerr << "Usage: " << command << " <title>|<borrower's name>|<borrower's id>" << endl;
+			return true;
+		}
+		if (command == "borrowBook") {
+			reportStatus(lcms.borrowBook(args[0], args[1], args[2]), "Book '" + args[0] + "' has been successfully issued to " + args[1] + " (ID: " + args[2] + ").");
+		} else {
+			reportStatus(lcms.returnBook(args[0], args[1], args[2]), "Book has been successfully returned.");
+		}
+	} else if (command == "removeBook") {
+		//No confirmation is asked in a batch
+		reportStatus(lcms.deleteBook(parameter), "Book '" + parameter + "' has been removed from the catalog.");
+	} else {
+		return runCommand(lcms, command, parameter);
+	}
+	return true;
+}
+//Function to run every command of a batch file without prompts, then report the time taken
+int runBatch(LCMS& lcms, const char* path)
+{
+	ifstream file(path);
+	if (!file) {
+		cerr << "We can't open the batch file, which is " << path << endl;
+		return EXIT_FAILURE;
+	}
+
+	//Buffer the output of the commands and write it once at the end, so the console does not slow the batch down
+	ostringstream output, errors;
+	streambuf* consoleOut = cout.rdbuf(output.rdbuf());
+	streambuf* consoleErr = cerr.rdbuf(errors.rdbuf());
+
+	MyHashMap<string, CommandTiming> timings;	//command -> number of runs and total time
+	MyVector<string> commandOrder;				//commands in the order they first ran
+	int lineNumber = 0, commands = 0;
+	string line, command, parameter;
+	chrono::steady_clock::time_point batchStart = chrono::steady_clock::now();
+	while (getline(file, line)) {
+		lineNumber++;
+		//Skip blank lines and comments, and accept files with Windows line endings
+		if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+		if (line.empty() || line[0] == '#') continue;
+
+		//Parse the line into command and parameter(s), as in the console
+		stringstream sstr(line);
+		parameter.clear();
+		getline(sstr, command, ' ');
+		getline(sstr, parameter);
+		if (command == "exit") break;
+
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		bool known = true;
+		try {
+			known = runBatchCommand(lcms, command, parameter);
+		} catch (exception& ex) {
+			cerr << "Line " << lineNumber << ": " << ex.what() << endl;
+		}
+		long long elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+		if (!known) {
+			cerr << "Line " << lineNumber << ": Invalid Command! " << command << endl;
+			continue;
+		}
+
+		//Add the time to the command
+		CommandTiming* timing = timings.find(command);
+		if (!timing) {
+			CommandTiming first = {0, 0};
+			timings.insert(command, first);
+			timing = timings.find(command);
+			commandOrder.push_back(command);
+		}
+		timing->count++;
+		timing->nanoseconds += elapsed;
+		commands++;
+	}
+	long long total = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - batchStart).count();
+
+	//Write the buffered output, then the timing report
+	cout.rdbuf(consoleOut);
+	cerr.rdbuf(consoleErr);
+	cout << output.str();
+	cerr << errors.str();
+
+	cout << fixed << setprecision(3);
+	cout << "Batch: " << commands << " commands in " << total / 1e6 << " ms";
+	if (total > 0) cout << " (" << commands / (total / 1e9) << " commands/s)";
+	cout << endl;
+	for (int i = 0; i < commandOrder.size(); i++) {
+		const CommandTiming& timing = *timings.find(commandOrder[i]);
+		cout << "  " << left << setw(22) << commandOrder[i] << right << setw(8) << timing.count << " runs "
+			 << setw(12) << timing.nanoseconds / 1e6 << " ms " << setw(12) << timing.nanoseconds / 1e3 / timing.count << " us/run";
+		if (timing.nanoseconds > 0) cout << setw(14) << timing.count / (timing.nanoseconds / 1e9) << " runs/s";
+		cout << endl;
+	}
+	return EXIT_SUCCESS;
+}
 //Function to display the available commands for user 
 void listCommands()
 {
@@ -78,6 +277,10 @@ void listCommands()
 		<<" import <file_name>                          : Read a Book file from a file"<<endl
 		<<" export <file_name>                          : Export Books to a file"<<endl
 		<<" findBook <title of the book>                : Search a book in the catalog"<<endl
+		<<" searchTitle <part of a title>               : Search the titles that contain the given text"<<endl
+		<<" findByIsbn <ISBN-10 or ISBN-13>             : Search a book by its ISBN"<<endl
+		<<" findByAuthor <author>[|<category>]          : List the books of an author, optionally in a category"<<endl
+		<<" findByYear <from> <to> [category]           : List the books published in a range of years"<<endl
 		<<" findAll <category/sub-category/..>          : List all books in a category/sub-category"<<endl
 		<<" addBook                                     : Add a book to the Catalog"<<endl
 		<<" editBook <title of the book>                : Edit a book detail in the catalog"<<endl
@@ -90,8 +293,17 @@ void listCommands()
 		<<" findCategory                                : Find a category in the catalog"<<endl
 		<<" addCategory <category/sub-category/...>     : Add a category/sub-category to the catalog"<<endl
 		<<" removeCategory <category/sub-category/...>  : Remove a category/sub-category from the catalog"<<endl
+		<<" snapshot save <file_name>                   : Save the whole catalog to a binary snapshot"<<endl
+		<<" snapshot load <file_name>                   : Replace the catalog with a binary snapshot"<<endl
+		<<" journal open <file_name>                    : Replay a journal and record further changes in it"<<endl
+		<<" journal recover <snapshot>|<journal>        : Load a snapshot, then replay and reopen the journal"<<endl
+		<<" journal close                               : Stop recording changes"<<endl
+		<<" summary <category>[|<from year>|<to year>]  : Count books, copies and years of a category"<<endl
+		<<" stats [reset | dump <file> [seconds] | dump off] : Show or reset command latencies, or dump them periodically"<<endl
+		<<" trace start <file_name> | trace stop        : Record import/export/findAll/removeCategory phases as a Chrome trace"<<endl
 		//<<" editCategory <category/sub-category/...>    : Edit a category/sub-category"<<endl
 		<<" list                                        : Display all categories from the catalog"<<endl
+		<<" (run \"lcms --batch <file>\" to run one command per line without prompts, e.g. borrowBook <title>|<name>|<id>)"<<endl
 		<<" help                                        : Display the list of available commands"<<endl
 		<<" exit                                        : Exit the Program"<<endl
 		<<" ====================================================================================\n"<<endl;	
@@ -0,0 +1,73 @@
+//============================================================================
+// Name         : mappedfile.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Read-only memory mapping of a file
+//============================================================================
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mappedfile.h"
+
+//Constructor
+MappedFile::MappedFile() : bytes(nullptr), length(0) {
+}
+
+//Deconstructor
+MappedFile::~MappedFile(){
+    close();
+}
+
+//Function to map the file at the given path
+bool MappedFile::open(const std::string& path){
+    close();
+    //Open the file and find out its size
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0){
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0){
+        ::close(fd);
+        return false;
+    }
+    length = (std::size_t)info.st_size;
+
+    //An empty file cannot be mapped, so it is represented by an empty range
+    if (length > 0){
+        void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED){
+            ::close(fd);
+            length = 0;
+            return false;
+        }
+        //The file is read from start to end, so let the kernel read ahead aggressively
+        madvise(mapping, length, MADV_SEQUENTIAL);
+        bytes = (const char*)mapping;
+    }
+    //The mapping stays valid after the descriptor is closed
+    ::close(fd);
+    return true;
+}
+
+//Function to unmap the file
+void MappedFile::close(){
+    if (bytes){
+        munmap((void*)bytes, length);
+    }
+    bytes = nullptr;
+    length = 0;
+}
+
+//Function to return the first byte of the file
+const char* MappedFile::data() const {
+    return bytes;
+}
+
+//Function to return the size of the file
+std::size_t MappedFile::size() const {
+    return length;
+}
@@ -0,0 +1,35 @@
+//============================================================================
+// Name         : mappedfile.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : header file for mappedfile.cpp
+//============================================================================
+#ifndef _MAPPEDFILE_H
+#define _MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+//Read-only memory mapping of a whole file
+class MappedFile
+{
+	private:
+		const char* bytes;		//first byte of the mapping (nullptr for an empty file)
+		std::size_t length;		//size of the file in bytes
+
+		MappedFile(const MappedFile&);				//a mapping cannot be copied
+		MappedFile& operator=(const MappedFile&);
+
+	public:
+		MappedFile();
+		~MappedFile();			//unmaps the file
+
+		bool open(const std::string& path);		//map the file at path, return false if it cannot be opened
+		void close();							//unmap the file
+		const char* data() const;				//return the first byte of the file
+		std::size_t size() const;				//return the size of the file
+};
+
+#endif
@@ -0,0 +1,302 @@
+//============================================================================
+// Name         : myhashmap.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Hash map implementation in C++ (open addressing, linear probing)
+//============================================================================
+#ifndef MYHASHMAP_H
+#define MYHASHMAP_H
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+template <typename K, typename V, typename H = std::hash<K> >
+class MyHashMap {
+	private:
+		K *keys;						//array of keys
+		V *values;						//array of values (values[i] belongs to keys[i])
+		bool *used;						//used[i] is true if slot i holds an entry
+		int m_size;						//number of entries in the map
+		int m_capacity;					//number of slots (always 0 or a power of two)
+		H hasher;						//hash function object
+
+		int home(const K& key) const;	//Return the preferred slot of a key
+		int slotOf(const K& key) const;	//Return the slot holding key, -1 if absent
+		void rehash(int newCapacity);	//Move every entry into a table of newCapacity slots
+
+	public:
+		MyHashMap();						//No argument constructor
+		MyHashMap(const MyHashMap& other);	//Copy Constructor
+		MyHashMap& operator=(const MyHashMap& other);	//Copy assignment
+		~MyHashMap();						//Destructor
+
+		V* find(const K& key);				//Return pointer to the value of key, nullptr if absent
+		const V* find(const K& key) const;	//Return pointer to the value of key, nullptr if absent
+		bool contains(const K& key) const;	//Return true if key is in the map
+		bool insert(const K& key, const V& value);	//Add key/value if key is absent, return true if added
+		V& operator[](const K& key);		//Return reference to the value of key, inserting V() if absent
+		bool erase(const K& key);			//Remove key, return true if it was present
+		void clear();						//Remove all entries
+		void reserve(int n);				//Make room for n entries without rehashing
+		int size() const;					//Return number of entries
+		bool empty() const;					//Return true if the map is empty
+		int capacity() const;				//Return number of slots (use with occupied/keyAt/valueAt to iterate)
+		bool occupied(int slot) const;		//Return true if the slot holds an entry
+		const K& keyAt(int slot) const;		//Return key stored in an occupied slot
+		V& valueAt(int slot);				//Return value stored in an occupied slot
+};
+//Function to compute the preferred slot of a key
+template <typename K, typename V, typename H>
+int MyHashMap<K, V, H>::home(const K& key) const
+{
+	//Mix the bits of the hash so that identity hashes (pointers, integers) spread over the table
+	unsigned long long h = (unsigned long long)hasher(key);
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	//Capacity is a power of two, so the mask keeps the low bits
+	return (int)(h & (unsigned long long)(m_capacity - 1));
+}
+//Function to locate the slot that holds the key
+template <typename K, typename V, typename H>
+int MyHashMap<K, V, H>::slotOf(const K& key) const
+{
+	//If the table has no slots, then the key cannot be present
+	if (m_capacity == 0){
+		return -1;
+	}
+	//Probe forward from the home slot until the key or an empty slot is found
+	for (int i = home(key); used[i]; i = (i + 1) & (m_capacity - 1)){
+		if (keys[i] == key){
+			return i;
+		}
+	}
+	return -1;
+}
+//Function to move every entry into a table with the given number of slots
+template <typename K, typename V, typename H>
+void MyHashMap<K, V, H>::rehash(int newCapacity)
+{
+	K* oldKeys = keys;
+	V* oldValues = values;
+	bool* oldUsed = used;
+	int oldCapacity = m_capacity;
+
+	//Allocate the new table with every slot empty
+	keys = new K[newCapacity];
+	values = new V[newCapacity];
+	used = new bool[newCapacity]();
+	m_capacity = newCapacity;
+
+	//Reinsert each entry of the old table at its new home
+	for (int i = 0; i < oldCapacity; i++){
+		if (oldUsed[i]){
+			int j = home(oldKeys[i]);
+			while (used[j]){
+				j = (j + 1) & (m_capacity - 1);
+			}
+			keys[j] = std::move(oldKeys[i]);
+			values[j] = std::move(oldValues[i]);
+			used[j] = true;
+		}
+	}
+	//Deallocate the old table
+	delete[] oldKeys;
+	delete[] oldValues;
+	delete[] oldUsed;
+}
+//Constructor with no argument (no memory is allocated until the first insert)
+template <typename K, typename V, typename H>
+MyHashMap<K, V, H>::MyHashMap() : keys(nullptr), values(nullptr), used(nullptr), m_size(0), m_capacity(0) {}
+//Copy constructor to copy all the entries from the other map
+template <typename K, typename V, typename H>
+MyHashMap<K, V, H>::MyHashMap(const MyHashMap &other) : keys(nullptr), values(nullptr), used(nullptr), m_size(0), m_capacity(0), hasher(other.hasher)
+{
+	*this = other;
+}
+//Copy assignment to replace the entries of this map with the entries of the other map
+template <typename K, typename V, typename H>
+MyHashMap<K, V, H>& MyHashMap<K, V, H>::operator=(const MyHashMap &other)
+{
+	if (this == &other){
+		return *this;
+	}
+	delete[] keys;
+	delete[] values;
+	delete[] used;
+	keys = nullptr;
+	values = nullptr;
+	used = nullptr;
+	m_size = other.m_size;
+	m_capacity = other.m_capacity;
+	//Slots are copied one to one since both tables use the same hash function
+	if (m_capacity > 0){
+		keys = new K[m_capacity];
+		values = new V[m_capacity];
+		used = new bool[m_capacity];
+		for (int i = 0; i < m_capacity; i++){
+			used[i] = other.used[i];
+			if (used[i]){
+				keys[i] = other.keys[i];
+				values[i] = other.values[i];
+			}
+		}
+	}
+	return *this;
+}
+//Destructor to deallocate the table
+template <typename K, typename V, typename H>
+MyHashMap<K, V, H>::~MyHashMap()
+{
+	delete[] keys;
+	delete[] values;
+	delete[] used;
+}
+//Function to return a pointer to the value of the given key
+template <typename K, typename V, typename H>
+V* MyHashMap<K, V, H>::find(const K& key)
+{
+	int slot = slotOf(key);
+	return slot < 0 ? nullptr : &values[slot];
+}
+//Function to return a pointer to the value of the given key
+template <typename K, typename V, typename H>
+const V* MyHashMap<K, V, H>::find(const K& key) const
+{
+	int slot = slotOf(key);
+	return slot < 0 ? nullptr : &values[slot];
+}
+//Function to check if the key is in the map
+template <typename K, typename V, typename H>
+bool MyHashMap<K, V, H>::contains(const K& key) const
+{
+	return slotOf(key) >= 0;
+}
+//Function to add a new entry if the key is not in the map yet
+template <typename K, typename V, typename H>
+bool MyHashMap<K, V, H>::insert(const K& key, const V& value)
+{
+	//If the key already exists, then leave its value untouched
+	if (slotOf(key) >= 0){
+		return false;
+	}
+	//Grow the table so that it is never more than 3/4 full
+	if ((m_size + 1) * 4 > m_capacity * 3){
+		rehash(m_capacity == 0 ? 8 : m_capacity * 2);
+	}
+	//Store the entry in the first empty slot after its home
+	int i = home(key);
+	while (used[i]){
+		i = (i + 1) & (m_capacity - 1);
+	}
+	keys[i] = key;
+	values[i] = value;
+	used[i] = true;
+	m_size++;
+	return true;
+}
+//Overload function to access the value of a key using [] operator
+template <typename K, typename V, typename H>
+V& MyHashMap<K, V, H>::operator[](const K& key)
+{
+	//If the key is absent, then insert it with a default value
+	int slot = slotOf(key);
+	if (slot < 0){
+		insert(key, V());
+		slot = slotOf(key);
+	}
+	return values[slot];
+}
+//Function to remove the entry of the given key
+template <typename K, typename V, typename H>
+bool MyHashMap<K, V, H>::erase(const K& key)
+{
+	int hole = slotOf(key);
+	if (hole < 0){
+		return false;
+	}
+	//Shift later entries of the probe run back into the hole so lookups never stop early
+	int mask = m_capacity - 1;
+	for (int j = (hole + 1) & mask; used[j]; j = (j + 1) & mask){
+		int h = home(keys[j]);
+		//The entry at j may move into the hole only if its home is not between the hole and j
+		bool movable = (hole <= j) ? (h <= hole || h > j) : (h <= hole && h > j);
+		if (movable){
+			keys[hole] = std::move(keys[j]);
+			values[hole] = std::move(values[j]);
+			hole = j;
+		}
+	}
+	//Release the contents of the last hole
+	keys[hole] = K();
+	values[hole] = V();
+	used[hole] = false;
+	m_size--;
+	return true;
+}
+//Function to remove all the entries of the map
+template <typename K, typename V, typename H>
+void MyHashMap<K, V, H>::clear()
+{
+	delete[] keys;
+	delete[] values;
+	delete[] used;
+	keys = nullptr;
+	values = nullptr;
+	used = nullptr;
+	m_size = 0;
+	m_capacity = 0;
+}
+//Function to make room for n entries
+template <typename K, typename V, typename H>
+void MyHashMap<K, V, H>::reserve(int n)
+{
+	int newCapacity = m_capacity == 0 ? 8 : m_capacity;
+	while (n * 4 > newCapacity * 3){
+		newCapacity *= 2;
+	}
+	if (newCapacity != m_capacity){
+		rehash(newCapacity);
+	}
+}
+//Function to return the number of entries
+template <typename K, typename V, typename H>
+int MyHashMap<K, V, H>::size() const
+{
+	return m_size;
+}
+//Function to check if the map is empty or not
+template <typename K, typename V, typename H>
+bool MyHashMap<K, V, H>::empty() const
+{
+	return m_size == 0;
+}
+//Function to return the number of slots
+template <typename K, typename V, typename H>
+int MyHashMap<K, V, H>::capacity() const
+{
+	return m_capacity;
+}
+//Function to check if the given slot holds an entry
+template <typename K, typename V, typename H>
+bool MyHashMap<K, V, H>::occupied(int slot) const
+{
+	return used[slot];
+}
+//Function to return the key stored in the given slot
+template <typename K, typename V, typename H>
+const K& MyHashMap<K, V, H>::keyAt(int slot) const
+{
+	return keys[slot];
+}
+//Function to return the value stored in the given slot
+template <typename K, typename V, typename H>
+V& MyHashMap<K, V, H>::valueAt(int slot)
+{
+	return values[slot];
+}
+
+#endif
@@ -3,203 +3,327 @@
 // Author       : Shota Matsumoto
 // Version      : 1.0
 // Date Created : 11/02/2024
-// Date Modified: 11/08/2024
+// Date Modified: 10/17/2026
 // Description  : Vector implementation in C++
 //============================================================================
 #ifndef MYVECTOR_H
 #define MYVECTOR_H
 
+#include <new>
 #include <stdexcept>
+#include <utility>
 
 template <typename T>
 class MyVector {
 	private:
-		T *data;						//pointer to int(array) to store elements
+		T *data;						//pointer to raw storage; only the first v_size slots hold constructed elements
 		int v_size;						//current size of vector (number of elements in vector)
 		int v_capacity;					//capacity of vector
 
-		void resize(){
-			v_capacity = v_capacity == 0 ? 1 : v_capacity * 2; 
-			T* newData = new T[v_capacity]; 
-			for (int i = 0; i < v_size; i++){
-				newData[i] = data[i]; 
-			}
-			delete[] data; 
-			data = newData; 
-		}
+		static T* allocate(int n);		//allocate raw storage for n elements (nullptr for 0)
+		void reallocate(int newCapacity);	//move the elements into new storage of newCapacity slots
+		void destroyAll();				//destroy the elements and release the storage
 
 	public:
-		MyVector();						//No argument constructor
+		typedef T* iterator;
+		typedef const T* const_iterator;
+
+		MyVector();						//No argument constructor (allocates nothing)
 		MyVector(int cap);				//One Argument Constructor
 		MyVector(const MyVector& other);		//Copy Constructor
+		MyVector(MyVector&& other) noexcept;	//Move Constructor
+		MyVector& operator=(const MyVector& other);		//Copy assignment
+		MyVector& operator=(MyVector&& other) noexcept;	//Move assignment
 		~MyVector();					//Destructor
 
-		void push_back(T element);		//Add an element at the end of vector
-		void insert(int index, T element); //Add an element at the index 
+		void push_back(const T& element);	//Add an element at the end of vector
+		void push_back(T&& element);		//Move an element to the end of vector
+		template <typename... Args>
+		T& emplace_back(Args&&... args);	//Construct an element in place at the end of vector
+		void pop_back();					//Remove the last element
+		void insert(int index, T element); //Add an element at the index
 		void erase(int index);			//Removes an element from the index
+		void clear();					//Removes all elements (capacity is kept)
 		T& operator[](int index);		//return reference of the element at index
+		const T& operator[](int index) const;	//return reference of the element at index
 		T& at(int index); 				//return reference of the element at index
 		const T& front();				//Returns reference of the first element in the vector
 		const T& back();				//Returns reference of the Last element in the vector
 		int size() const;				//Return current size of vector
 		int capacity() const;			//Return capacity of vector
 		bool empty() const; 			//Return true if the vector is empty, False otherwise
+		void reserve(int cap);			//Make room for at least cap elements
 		void shrink_to_fit();			//Reduce vector capacity to fit its size
+
+		iterator begin() { return data; }
+		iterator end() { return data + v_size; }
+		const_iterator begin() const { return data; }
+		const_iterator end() const { return data + v_size; }
 };
-//Constructor with no argument 
+//Function to allocate raw storage without constructing any element
+template <typename T>
+T* MyVector<T>::allocate(int n)
+{
+	return n == 0 ? nullptr : static_cast<T*>(::operator new(sizeof(T) * n));
+}
+//Function to move the elements into new storage
+template <typename T>
+void MyVector<T>::reallocate(int newCapacity)
+{
+	T* newData = allocate(newCapacity);
+	//Move each element into the new storage (copy if moving could throw) and destroy the old one
+	for (int i = 0; i < v_size; i++){
+		::new (newData + i) T(std::move_if_noexcept(data[i]));
+		data[i].~T();
+	}
+	::operator delete(data);
+	data = newData;
+	v_capacity = newCapacity;
+}
+//Function to destroy all the elements and release the storage
 template <typename T>
-MyVector<T>::MyVector() : v_size(0), v_capacity(1) {
-	//Allocate the memory space for the vector with the initial capacity of 1
-	data = new T[v_capacity]; 
+void MyVector<T>::destroyAll()
+{
+	for (int i = 0; i < v_size; i++){
+		data[i].~T();
+	}
+	::operator delete(data);
+	data = nullptr;
+	v_size = 0;
+	v_capacity = 0;
 }
-//Constructor with one argument 
+//Constructor with no argument
+template <typename T>
+MyVector<T>::MyVector() : data(nullptr), v_size(0), v_capacity(0) {
+	//An empty vector allocates nothing until the first element is added
+}
+//Constructor with one argument
 template <typename T>
 MyVector<T>::MyVector(int cap) : v_size(0), v_capacity(cap) {
-	//Create a vector that holds the capacity of v_capacity
-	data = new T[v_capacity]; 
+	//Reserve room for v_capacity elements without constructing them
+	data = allocate(v_capacity);
 }
 //Copy construtor to copy all the information including size, capacity, and elements from the other object into newly made vector
 template <typename T>
-MyVector<T>::MyVector(const MyVector &other) : v_size (other.v_size), v_capacity(other.v_capacity) {
-	//Create an array of type T with the capacity of v_capacity 
-	data = new T[v_capacity]; 
-	
-	//Iterate through each element of the other data to store them into the new array 
-	for (int i = 0; i < v_size; i++){
-		data[i] = other.data[i]; 
+MyVector<T>::MyVector(const MyVector &other) : v_size(0), v_capacity(other.v_size) {
+	//Allocate just enough room for the elements of the other vector
+	data = allocate(v_capacity);
+
+	//Iterate through each element of the other data to copy them into the new storage
+	for (int i = 0; i < other.v_size; i++){
+		::new (data + i) T(other.data[i]);
+		v_size++;
 	}
 }
+//Move constructor to take over the storage of the other vector, leaving it empty
+template <typename T>
+MyVector<T>::MyVector(MyVector &&other) noexcept : data(other.data), v_size(other.v_size), v_capacity(other.v_capacity) {
+	other.data = nullptr;
+	other.v_size = 0;
+	other.v_capacity = 0;
+}
+//Copy assignment to replace the elements of this vector with copies of the elements of the other vector
+template <typename T>
+MyVector<T>& MyVector<T>::operator=(const MyVector &other)
+{
+	//Copy into a temporary first, so this vector is unchanged if copying throws
+	if (this != &other){
+		MyVector copy(other);
+		*this = std::move(copy);
+	}
+	return *this;
+}
+//Move assignment to take over the storage of the other vector, leaving it empty
+template <typename T>
+MyVector<T>& MyVector<T>::operator=(MyVector &&other) noexcept
+{
+	if (this != &other){
+		destroyAll();
+		data = other.data;
+		v_size = other.v_size;
+		v_capacity = other.v_capacity;
+		other.data = nullptr;
+		other.v_size = 0;
+		other.v_capacity = 0;
+	}
+	return *this;
+}
 //Deconstructor to delete all
 template <typename T>
 MyVector<T>::~MyVector() {
-	//Dynamically deallocate the memory space of data 
-	delete[] data; 
+	//Destroy the elements and deallocate the storage
+	destroyAll();
 }
-//Function to return the value of the size of vector 
+//Function to return the value of the size of vector
 template <typename T>
 int MyVector<T>::size() const
 {
-	//Return the size of vector 
-	return v_size; 
+	//Return the size of vector
+	return v_size;
 }
-//Function to return the value of the capacity 
+//Function to return the value of the capacity
 template <typename T>
 int MyVector<T>::capacity() const
 {
-	//Return the capacity of vector 
-	return v_capacity; 
+	//Return the capacity of vector
+	return v_capacity;
 }
-//Function to check if vector is empty or not 
+//Function to check if vector is empty or not
 template <typename T>
 bool MyVector<T>::empty() const
 {
 	//Return true if the size is 0
-	return v_size == 0; 
+	return v_size == 0;
+}
+//Function to add a copy of an element at the end of vector
+template <typename T>
+void MyVector<T>::push_back(const T& element) {
+	emplace_back(element);
 }
-//Function to add a new element at the end of vector 
+//Function to move an element to the end of vector
 template <typename T>
-void MyVector<T>::push_back(T element) {
-	//If the size of the vector is larger or equal to the capacity of vector
+void MyVector<T>::push_back(T&& element) {
+	emplace_back(std::move(element));
+}
+//Function to construct a new element at the end of vector from the given arguments
+template <typename T>
+template <typename... Args>
+T& MyVector<T>::emplace_back(Args&&... args) {
+	//If the vector is full, then double its capacity
 	if (v_size >= v_capacity){
-		resize(); 
+		int newCapacity = v_capacity == 0 ? 1 : v_capacity * 2;
+		T* newData = allocate(newCapacity);
+		//Construct the new element first, since the arguments may refer to an element of this vector
+		::new (newData + v_size) T(std::forward<Args>(args)...);
+		for (int i = 0; i < v_size; i++){
+			::new (newData + i) T(std::move_if_noexcept(data[i]));
+			data[i].~T();
+		}
+		::operator delete(data);
+		data = newData;
+		v_capacity = newCapacity;
+	} else {
+		//Construct the new element in the first free slot
+		::new (data + v_size) T(std::forward<Args>(args)...);
 	}
-	//Append a new element at the end of vector 
-	data[v_size++] = element; 
+	return data[v_size++];
 }
-//Function to insert an element at a specified index in the vector 
-template <typename T>	
+//Function to remove the last element of the vector
+template <typename T>
+void MyVector<T>::pop_back() {
+	//If vector is empty, then display an error message indicating that the vector is empty
+	if (empty()){
+		throw std::out_of_range("Vector is empty!");
+	}
+	data[--v_size].~T();
+}
+//Function to insert an element at a specified index in the vector
+template <typename T>
 void MyVector<T>::insert(int index, T element)
 {
-	//If index is out of range, then display an error message 
+	//If index is out of range, then display an error message
 	if (index < 0 || index >= v_size){
-		throw std::out_of_range("Index is out of range"); 
+		throw std::out_of_range("Index is out of range");
 	}
 
-	//If the size of vector is larger than its capacity, then resize its capapacity by calling resize function 
+	//If the size of vector is larger than its capacity, then double its capacity
 	if (v_size >= v_capacity){
-		resize(); 
+		reallocate(v_capacity * 2);
 	}
-	//Shift all the elements to the right for the sake of the space for new element 
-	for (int i = v_size; i > index; i--){
-		data[i] = data[i - 1]; 
+	//Shift all the elements to the right for the sake of the space for new element
+	::new (data + v_size) T(std::move(data[v_size - 1]));
+	for (int i = v_size - 1; i > index; i--){
+		data[i] = std::move(data[i - 1]);
 	}
 	//Insert a new element at the specified index
-	data[index] = element; 
+	data[index] = std::move(element);
 	//Increment size by one
-	v_size++; 
+	v_size++;
 }
-//Function to remove the element at the specified index in the vector 
-template <typename T>	
+//Function to remove the element at the specified index in the vector
+template <typename T>
 void MyVector<T>::erase(int index) {
-	//If the index is out of range then display an error message 
+	//If the index is out of range then display an error message
 	if (index < 0 || index >= v_size){
-		throw std::out_of_range("Index is out of range"); 
+		throw std::out_of_range("Index is out of range");
 	}
 
-	//Shift all the elements to the left to make a space for newly added element 
+	//Shift all the elements after the index to the left to close the gap
 	for (int i = index; i < v_size - 1; i++){
-		data[i] = data[i + 1]; 
+		data[i] = std::move(data[i + 1]);
 	}
-	//Decrease the size of vector by 1 
-	v_size--; 
+	//Destroy the last element, which has been moved from, and decrease the size of vector by 1
+	data[--v_size].~T();
 }
-//Overload function to access elements at the specific index using [] operator 
+//Function to remove all the elements of the vector
+template <typename T>
+void MyVector<T>::clear() {
+	for (int i = 0; i < v_size; i++){
+		data[i].~T();
+	}
+	v_size = 0;
+}
+//Overload function to access elements at the specific index using [] operator
 template <typename T>
 T& MyVector<T>::operator[](int index) {
-	//Return the element at the given index 
-	return data[index]; 
+	//Return the element at the given index
+	return data[index];
+}
+//Overload function to access elements of a const vector using [] operator
+template <typename T>
+const T& MyVector<T>::operator[](int index) const {
+	//Return the element at the given index
+	return data[index];
 }
 //Function to access the element at the given index with the boundary check as well
 template <typename T>
 T& MyVector<T>::at(int index) {
 	//If the index is out of range, then display an error message
 	if (index < 0 || index >= v_size){
-		throw std::out_of_range("Index is out of range"); 
+		throw std::out_of_range("Index is out of range");
 	}
-	//Return the element at the given index 
-	return data[index]; 
+	//Return the element at the given index
+	return data[index];
 }
-//Function to return the first element of the vector 
+//Function to return the first element of the vector
 template <typename T>
 const T& MyVector<T>::front()
 {
 	//If vector is empty, then display an error message indicating that the vector is empty
 	if (empty()){
-		throw std::out_of_range("Vector is empty!"); 
+		throw std::out_of_range("Vector is empty!");
 	}
-    //Return the first element of the vector 
-	return data[0]; 
+    //Return the first element of the vector
+	return data[0];
 }
-//Function to return the element at the last index 
+//Function to return the element at the last index
 template <typename T>
 const T& MyVector<T>::back()
 {
 	//If vector is empty, then display an error message indicating that the vector is empty
 	if (empty()){
-		throw std::out_of_range("Vector is empty!"); 
+		throw std::out_of_range("Vector is empty!");
 	}
-	//Return the last element 
-	return data[v_size - 1]; 
+	//Return the last element
+	return data[v_size - 1];
 }
-//Function to reduce the capacity of the vector to the size of it 
+//Function to make room for at least cap elements
+template <typename T>
+void MyVector<T>::reserve(int cap)
+{
+	//Only grow; elements are moved into the larger storage
+	if (cap > v_capacity){
+		reallocate(cap);
+	}
+}
+//Function to reduce the capacity of the vector to the size of it
 template <typename T>
 void MyVector<T>::shrink_to_fit()
 {
-	//If size of the vector is smaller than its capacity
+	//If size of the vector is smaller than its capacity, then move the elements into storage of exactly v_size slots
 	if (v_size < v_capacity){
-		//Create vector called newData with the capacity of v_size 
-		T* newData = new T[v_size]; 
-		//Iterate through each element in the data to copy them into newData
-		for (int i = 0; i < v_size; i++){
-			newData[i] = data[i]; 
-		}
-		//Dynamically deallocate the memory space of data 
-		delete[] data; 
-		//Assign newData to data
-		data = newData; 
-		//Assign size to capacity 
-		v_capacity = v_size; 
+		reallocate(v_size);
 	}
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,159 @@
+//============================================================================
+// Name         : objectpool.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Slab allocator for objects of one type with free-list reuse
+//============================================================================
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "myvector.h"
+
+template <typename T>
+class ObjectPool {
+	private:
+		//A slot holds either a live object or the link to the next free slot
+		struct Slot {
+			union {
+				Slot* next;											//next free slot (while the slot is free)
+				typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;	//the object (while the slot is live)
+			};
+			bool live;												//true if the slot holds a constructed object
+		};
+
+		static const int FIRST_SLAB_SIZE = 64;		//slots in the first slab; each later slab doubles up to MAX_SLAB_SIZE
+		static const int MAX_SLAB_SIZE = 8192;
+
+		MyVector<Slot*> slabs;						//every slab allocated so far
+		MyVector<int> slabSizes;					//slabSizes[i] is the number of slots of slabs[i]
+		Slot* freeList;								//released slots, reused before the current slab is touched
+		Slot* nextFresh;							//first never-used slot of the last slab
+		Slot* slabEnd;								//one past the last slot of the last slab
+		int p_size;									//number of live objects
+
+		ObjectPool(const ObjectPool&);				//the pool owns its objects, so it cannot be copied
+		ObjectPool& operator=(const ObjectPool&);
+
+		Slot* takeSlot();							//Return a free slot, allocating a new slab if needed
+
+	public:
+		ObjectPool();								//No argument constructor (allocates nothing)
+		~ObjectPool();								//Destroys every live object and deallocates the slabs
+
+		template <typename... Args>
+		T* create(Args&&... args);					//Construct a new object in a free slot
+		void destroy(T* object);					//Destroy an object of this pool and put its slot on the free list
+		void releaseAll();							//Destroy every live object and deallocate every slab at once
+		int size() const;							//Return number of live objects
+};
+//Constructor with no argument
+template <typename T>
+ObjectPool<T>::ObjectPool() : freeList(nullptr), nextFresh(nullptr), slabEnd(nullptr), p_size(0) {}
+//Destructor to release every object at once
+template <typename T>
+ObjectPool<T>::~ObjectPool()
+{
+	releaseAll();
+}
+//Function to return a slot for a new object
+template <typename T>
+typename ObjectPool<T>::Slot* ObjectPool<T>::takeSlot()
+{
+	//Reuse the most recently released slot first
+	if (freeList){
+		Slot* slot = freeList;
+		freeList = slot->next;
+		return slot;
+	}
+	//If the last slab is full, then allocate a new slab twice as large (up to MAX_SLAB_SIZE)
+	if (nextFresh == slabEnd){
+		int slabSize = slabs.empty() ? FIRST_SLAB_SIZE : slabSizes[slabSizes.size() - 1] * 2;
+		if (slabSize > MAX_SLAB_SIZE){
+			slabSize = MAX_SLAB_SIZE;
+		}
+		Slot* slab = static_cast<Slot*>(::operator new(sizeof(Slot) * slabSize));
+		for (int i = 0; i < slabSize; i++){
+			slab[i].live = false;
+		}
+		slabs.push_back(slab);
+		slabSizes.push_back(slabSize);
+		nextFresh = slab;
+		slabEnd = slab + slabSize;
+	}
+	//Hand out the slots of the last slab in address order
+	return nextFresh++;
+}
+//Function to construct a new object of the pool
+template <typename T>
+template <typename... Args>
+T* ObjectPool<T>::create(Args&&... args)
+{
+	Slot* slot = takeSlot();
+	T* object;
+	try {
+		object = ::new (&slot->storage) T(std::forward<Args>(args)...);
+	} catch (...) {
+		//If the constructor throws, then give the slot back
+		slot->next = freeList;
+		freeList = slot;
+		throw;
+	}
+	slot->live = true;
+	p_size++;
+	return object;
+}
+//Function to destroy an object and make its slot available again
+template <typename T>
+void ObjectPool<T>::destroy(T* object)
+{
+	//If the object is nullptr, then there is nothing to destroy (as with delete)
+	if (object == nullptr){
+		return;
+	}
+	//The object is the storage member of its slot, which sits at the start of the slot
+	Slot* slot = reinterpret_cast<Slot*>(object);
+	object->~T();
+	slot->live = false;
+	slot->next = freeList;
+	freeList = slot;
+	p_size--;
+}
+//Function to destroy every live object and deallocate the slabs
+template <typename T>
+void ObjectPool<T>::releaseAll()
+{
+	//Walk the slabs in address order to run the destructors (skipped entirely for trivial types)
+	if (!std::is_trivially_destructible<T>::value){
+		for (int i = 0; i < slabs.size() && p_size > 0; i++){
+			for (int j = 0; j < slabSizes[i]; j++){
+				if (slabs[i][j].live){
+					reinterpret_cast<T*>(&slabs[i][j].storage)->~T();
+					p_size--;
+				}
+			}
+		}
+	}
+	//Deallocate the slabs themselves, one call per slab rather than one per object
+	for (int i = 0; i < slabs.size(); i++){
+		::operator delete(slabs[i]);
+	}
+	slabs.clear();
+	slabSizes.clear();
+	freeList = nullptr;
+	nextFresh = nullptr;
+	slabEnd = nullptr;
+	p_size = 0;
+}
+//Function to return the number of live objects
+template <typename T>
+int ObjectPool<T>::size() const
+{
+	return p_size;
+}
+
+#endif
@@ -0,0 +1,46 @@
+//============================================================================
+// Name         : rwlock.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Reader/writer lock on top of pthread_rwlock_t
+//============================================================================
+#include "rwlock.h"
+
+//Constructor
+RwLock::RwLock(){
+    pthread_rwlockattr_t attributes;
+    pthread_rwlockattr_init(&attributes);
+#ifdef __GLIBC__
+    //glibc prefers readers by default, which lets steady circulation traffic starve a writer
+    pthread_rwlockattr_setkind_np(&attributes, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif
+    pthread_rwlock_init(&handle, &attributes);
+    pthread_rwlockattr_destroy(&attributes);
+}
+
+//Deconstructor
+RwLock::~RwLock(){
+    pthread_rwlock_destroy(&handle);
+}
+
+//Function to hold the lock as a reader
+void RwLock::lockShared(){
+    pthread_rwlock_rdlock(&handle);
+}
+
+//Function to release the lock held as a reader
+void RwLock::unlockShared(){
+    pthread_rwlock_unlock(&handle);
+}
+
+//Function to hold the lock as the writer
+void RwLock::lock(){
+    pthread_rwlock_wrlock(&handle);
+}
+
+//Function to release the lock held as the writer
+void RwLock::unlock(){
+    pthread_rwlock_unlock(&handle);
+}
@@ -0,0 +1,57 @@
+//============================================================================
+// Name         : rwlock.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : header file for rwlock.cpp
+//============================================================================
+#ifndef _RWLOCK_H
+#define _RWLOCK_H
+
+#include <pthread.h>
+
+//Reader/writer lock: any number of readers or a single writer (C++11 has no shared mutex)
+class RwLock
+{
+	private:
+		pthread_rwlock_t handle;
+
+		RwLock(const RwLock&);					//a lock cannot be copied
+		RwLock& operator=(const RwLock&);
+
+	public:
+		RwLock();								//waiting writers are preferred so a stream of readers cannot starve them
+		~RwLock();
+
+		void lockShared();						//wait until no writer holds the lock, then hold it as a reader
+		void unlockShared();
+		void lock();							//wait until nobody holds the lock, then hold it as the writer
+		void unlock();
+};
+
+//Holds an RwLock as a reader for the lifetime of the guard
+class ReadGuard
+{
+	private:
+		RwLock& rwlock;
+		ReadGuard(const ReadGuard&);
+		ReadGuard& operator=(const ReadGuard&);
+	public:
+		explicit ReadGuard(RwLock& rwlock) : rwlock(rwlock) { rwlock.lockShared(); }
+		~ReadGuard() { rwlock.unlockShared(); }
+};
+
+//Holds an RwLock as the writer for the lifetime of the guard
+class WriteGuard
+{
+	private:
+		RwLock& rwlock;
+		WriteGuard(const WriteGuard&);
+		WriteGuard& operator=(const WriteGuard&);
+	public:
+		explicit WriteGuard(RwLock& rwlock) : rwlock(rwlock) { rwlock.lock(); }
+		~WriteGuard() { rwlock.unlock(); }
+};
+
+#endif
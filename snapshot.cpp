@@ -0,0 +1,364 @@
+//============================================================================
+// Name         : snapshot.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Saving and loading the whole catalog as a binary, memory-mappable snapshot
+//============================================================================
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "lcms.h"
+#include "mappedfile.h"
+#include "myhashmap.h"
+#include "snapshot.h"
+
+using namespace std;
+
+//Function to flush a file or a directory to disk, return false if it fails
+static bool syncPath(const string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+}
+
+//Function to return the directory that holds a file
+static string directoryOf(const string& path) {
+    size_t slash = path.find_last_of('/');
+    if (slash == string::npos) {
+        return ".";
+    }
+    return slash == 0 ? "/" : path.substr(0, slash);
+}
+
+//String table of a snapshot being written; equal strings (e.g. authors) are stored once
+class StringTableWriter
+{
+	private:
+		string table;
+		MyHashMap<string, SnapshotString> stored;
+
+	public:
+		//Function to add a string to the table and return where it lives
+		SnapshotString add(const string& text){
+			SnapshotString* found = stored.find(text);
+			if (found){
+				return *found;
+			}
+			SnapshotString ref = {(uint32_t)table.size(), (uint32_t)text.size()};
+			table += text;
+			stored.insert(text, ref);
+			return ref;
+		}
+		const string& data() const { return table; }
+};
+
+//Function to round an offset up to the next multiple of 8 so that every section is aligned
+static uint64_t align8(uint64_t offset){
+    return (offset + 7) & ~(uint64_t)7;
+}
+
+//Function to write a section at the given offset, padding the file up to it
+static void writeSection(ofstream& file, uint64_t& position, uint64_t offset, const void* data, uint64_t size){
+    static const char padding[8] = {0};
+    file.write(padding, (streamsize)(offset - position));
+    file.write((const char*)data, (streamsize)size);
+    position = offset + size;
+}
+
+//Function to check that a section of count records lies inside the file
+static bool sectionFits(uint64_t offset, uint64_t count, uint64_t recordSize, uint64_t fileSize){
+    return offset % 8 == 0 && offset <= fileSize && count <= (fileSize - offset) / recordSize;
+}
+
+//Function to check that a string lies inside the string table
+static bool textFits(const SnapshotString& text, uint64_t tableSize){
+    return text.offset <= tableSize && text.length <= tableSize - text.offset;
+}
+
+//Function to check that every link refers to an existing book and borrower
+static bool linksFit(const SnapshotLink* links, uint32_t count, uint32_t bookCount, uint32_t borrowerCount){
+    for (uint32_t i = 0; i < count; i++){
+        if (links[i].book >= bookCount || links[i].borrower >= borrowerCount){
+            return false;
+        }
+    }
+    return true;
+}
+
+//Function to handle the snapshot command ("save <file>" or "load <file>")
+void LCMS::snapshot(string parameter){
+    stringstream sstr(parameter);
+    string action, path;
+    getline(sstr, action, ' ');
+    getline(sstr, path);
+    if (action == "save" && !path.empty()) {
+        saveSnapshot(path);
+    } else if (action == "load" && !path.empty()) {
+        loadSnapshot(path);
+    } else {
+        cerr << "Usage: snapshot save <file> | snapshot load <file>" << endl;
+    }
+}
+
+//Function to write the whole catalog to a snapshot file
+bool LCMS::saveSnapshot(string path){
+    StringTableWriter strings;
+    vector<SnapshotNode> nodes;
+    vector<SnapshotBook> books;
+    vector<SnapshotBorrower> borrowerRecords;
+    vector<SnapshotLink> bookLoans, borrowerLoans, history;
+    vector<Book*> bookList;
+    MyHashMap<Book*, uint32_t> bookIndex;
+    MyHashMap<Borrower*, uint32_t> borrowerIndex;
+
+    //The writer lock keeps circulation from changing the loans while the image is taken
+    WriteGuard guard(catalogLock);
+
+    //Walk the tree in pre-order so that every parent is written before its children
+    MyVector<Node*> nodes_stack;
+    MyVector<uint32_t> parents_stack;
+    nodes_stack.push_back(libTree->getRoot());
+    parents_stack.push_back(SNAPSHOT_NO_PARENT);
+    while (!nodes_stack.empty()) {
+        Node* node = nodes_stack.back();
+        uint32_t parent = parents_stack.back();
+        nodes_stack.pop_back();
+        parents_stack.pop_back();
+
+        uint32_t index = (uint32_t)nodes.size();
+        SnapshotNode record = {parent, strings.add(node->name)};
+        nodes.push_back(record);
+
+        //Write the books of the node
+        for (int i = 0; i < node->books.size(); i++) {
+            Book* book = node->books[i];
+            SnapshotBook bookRecord = {strings.add(book->title), strings.add(book->getAuthor(authorNames)), strings.add(book->isbn),
+                                       book->publication_year, book->total_copies, book->available_copies, index};
+            bookIndex.insert(book, (uint32_t)books.size());
+            bookList.push_back(book);
+            books.push_back(bookRecord);
+        }
+        //Push the children in reverse so that they come off the stack in their original order
+        for (int i = node->children.size() - 1; i >= 0; i--) {
+            nodes_stack.push_back(node->children[i]);
+            parents_stack.push_back(index);
+        }
+    }
+
+    //Write the borrowers in registration order
+    for (int i = 0; i < borrowers.size(); i++) {
+        SnapshotBorrower record = {strings.add(borrowers[i]->name), strings.add(borrowers[i]->id)};
+        borrowerIndex.insert(borrowers[i], (uint32_t)i);
+        borrowerRecords.push_back(record);
+    }
+
+    //Write the loans from the side of the books and from the side of the borrowers, keeping both orders
+    for (int i = 0; i < borrowers.size(); i++) {
+        Borrower* borrower = borrowers[i];
+        for (int j = 0; j < borrower->books_borrowed.size(); j++) {
+            uint32_t* book = bookIndex.find(borrower->books_borrowed[j]);
+            if (book) {
+                SnapshotLink link = {*book, (uint32_t)i};
+                borrowerLoans.push_back(link);
+            }
+        }
+    }
+    for (uint32_t index = 0; index < bookList.size(); index++) {
+        Book* book = bookList[index];
+        for (int j = 0; j < book->currentBorrowers.size(); j++) {
+            SnapshotLink link = {index, *borrowerIndex.find(book->currentBorrowers[j])};
+            bookLoans.push_back(link);
+        }
+        for (int j = 0; j < book->allBorrowers.size(); j++) {
+            SnapshotLink link = {index, *borrowerIndex.find(book->allBorrowers[j])};
+            history.push_back(link);
+        }
+    }
+
+    //Lay out the sections one after another, each aligned to 8 bytes
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.nodeCount = (uint32_t)nodes.size();
+    header.bookCount = (uint32_t)books.size();
+    header.borrowerCount = (uint32_t)borrowerRecords.size();
+    header.bookLoanCount = (uint32_t)bookLoans.size();
+    header.borrowerLoanCount = (uint32_t)borrowerLoans.size();
+    header.historyCount = (uint32_t)history.size();
+    header.nodesOffset = align8(sizeof(header));
+    header.booksOffset = align8(header.nodesOffset + nodes.size() * sizeof(SnapshotNode));
+    header.borrowersOffset = align8(header.booksOffset + books.size() * sizeof(SnapshotBook));
+    header.bookLoansOffset = align8(header.borrowersOffset + borrowerRecords.size() * sizeof(SnapshotBorrower));
+    header.borrowerLoansOffset = align8(header.bookLoansOffset + bookLoans.size() * sizeof(SnapshotLink));
+    header.historyOffset = align8(header.borrowerLoansOffset + borrowerLoans.size() * sizeof(SnapshotLink));
+    header.stringsOffset = align8(header.historyOffset + history.size() * sizeof(SnapshotLink));
+    header.stringsSize = strings.data().size();
+
+    //Write to a temporary file and rename it, so that a failed save never destroys the previous snapshot
+    string tempPath = path + ".tmp";
+    ofstream file(tempPath.c_str(), ios::binary | ios::trunc);
+    if (!file.is_open()) {
+        cerr << "We can't open the provided file, which is " << path << endl;
+        return false;
+    }
+    uint64_t position = 0;
+    writeSection(file, position, 0, &header, sizeof(header));
+    writeSection(file, position, header.nodesOffset, nodes.data(), nodes.size() * sizeof(SnapshotNode));
+    writeSection(file, position, header.booksOffset, books.data(), books.size() * sizeof(SnapshotBook));
+    writeSection(file, position, header.borrowersOffset, borrowerRecords.data(), borrowerRecords.size() * sizeof(SnapshotBorrower));
+    writeSection(file, position, header.bookLoansOffset, bookLoans.data(), bookLoans.size() * sizeof(SnapshotLink));
+    writeSection(file, position, header.borrowerLoansOffset, borrowerLoans.data(), borrowerLoans.size() * sizeof(SnapshotLink));
+    writeSection(file, position, header.historyOffset, history.data(), history.size() * sizeof(SnapshotLink));
+    writeSection(file, position, header.stringsOffset, strings.data().data(), strings.data().size());
+    file.close();
+    //The snapshot must be on disk before it replaces the previous one and before the journal is emptied,
+    //so flush the file before the rename and the directory (which holds the new name) after it
+    if (!file || !syncPath(tempPath) || rename(tempPath.c_str(), path.c_str()) != 0) {
+        cerr << "Failed to write the snapshot to: " << path << endl;
+        remove(tempPath.c_str());
+        return false;
+    }
+    if (!syncPath(directoryOf(path))) {
+        //Without the directory on disk the rename may be lost, so the journal still holds the only copy of the changes
+        cerr << "Warning: the snapshot could not be flushed to disk, the journal is kept!" << endl;
+        return false;
+    }
+
+    //The snapshot holds every change recorded so far, so the journal starts over
+    if (changeLog.isOpen() && !changeLog.truncate()) {
+        cerr << "Warning: the journal could not be emptied after the snapshot!" << endl;
+    }
+
+    cout << "Snapshot of " << books.size() << " books and " << borrowerRecords.size() << " borrowers has been saved to: " << path << endl;
+    return true;
+}
+
+//Function to replace the catalog with the contents of a snapshot file
+bool LCMS::loadSnapshot(string path){
+    //Map the snapshot into memory
+    MappedFile file;
+    if (!file.open(path)) {
+        cerr << "We can't open the file you have provided me with, which is " << path << endl;
+        return false;
+    }
+    const char* base = file.data();
+    uint64_t size = file.size();
+
+    //Check the header and that every section and string lies inside the file before touching the catalog
+    SnapshotHeader header;
+    if (size < sizeof(header)) {
+        cerr << "Invalid snapshot file: " << path << endl;
+        return false;
+    }
+    memcpy(&header, base, sizeof(header));
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.version != SNAPSHOT_VERSION) {
+        cerr << "Invalid snapshot file or unsupported version: " << path << endl;
+        return false;
+    }
+    bool valid = header.nodeCount > 0
+        && sectionFits(header.nodesOffset, header.nodeCount, sizeof(SnapshotNode), size)
+        && sectionFits(header.booksOffset, header.bookCount, sizeof(SnapshotBook), size)
+        && sectionFits(header.borrowersOffset, header.borrowerCount, sizeof(SnapshotBorrower), size)
+        && sectionFits(header.bookLoansOffset, header.bookLoanCount, sizeof(SnapshotLink), size)
+        && sectionFits(header.borrowerLoansOffset, header.borrowerLoanCount, sizeof(SnapshotLink), size)
+        && sectionFits(header.historyOffset, header.historyCount, sizeof(SnapshotLink), size)
+        && header.stringsOffset <= size && header.stringsSize <= size - header.stringsOffset;
+    if (!valid) {
+        cerr << "Invalid snapshot file: " << path << endl;
+        return false;
+    }
+
+    //The sections are aligned, so the records can be read in place
+    const SnapshotNode* nodes = (const SnapshotNode*)(base + header.nodesOffset);
+    const SnapshotBook* books = (const SnapshotBook*)(base + header.booksOffset);
+    const SnapshotBorrower* borrowerRecords = (const SnapshotBorrower*)(base + header.borrowersOffset);
+    const SnapshotLink* bookLoans = (const SnapshotLink*)(base + header.bookLoansOffset);
+    const SnapshotLink* borrowerLoans = (const SnapshotLink*)(base + header.borrowerLoansOffset);
+    const SnapshotLink* history = (const SnapshotLink*)(base + header.historyOffset);
+    const char* strings = base + header.stringsOffset;
+
+    //Check every reference: strings inside the table, parents before children, links to existing records
+    valid = nodes[0].parent == SNAPSHOT_NO_PARENT && textFits(nodes[0].name, header.stringsSize);
+    for (uint32_t i = 1; valid && i < header.nodeCount; i++) {
+        valid = nodes[i].parent < i && textFits(nodes[i].name, header.stringsSize);
+    }
+    for (uint32_t i = 0; valid && i < header.bookCount; i++) {
+        valid = books[i].node < header.nodeCount && textFits(books[i].title, header.stringsSize)
+            && textFits(books[i].author, header.stringsSize) && textFits(books[i].isbn, header.stringsSize);
+    }
+    for (uint32_t i = 0; valid && i < header.borrowerCount; i++) {
+        valid = textFits(borrowerRecords[i].name, header.stringsSize) && textFits(borrowerRecords[i].id, header.stringsSize);
+    }
+    valid = valid && linksFit(bookLoans, header.bookLoanCount, header.bookCount, header.borrowerCount)
+        && linksFit(borrowerLoans, header.borrowerLoanCount, header.bookCount, header.borrowerCount)
+        && linksFit(history, header.historyCount, header.bookCount, header.borrowerCount);
+    if (!valid) {
+        cerr << "Invalid snapshot file: " << path << endl;
+        return false;
+    }
+
+    //Replace the current catalog. The open journal only holds changes made after the snapshot it was emptied for,
+    //so loading any snapshot under it would mix the two; recover loads the snapshot before opening the journal
+    WriteGuard guard(catalogLock);
+    if (changeLog.isOpen()) {
+        cerr << "Close the journal before loading a snapshot, or use journal recover!" << endl;
+        return false;
+    }
+    clearCatalog();
+    libTree = new Tree(string(strings + nodes[0].name.offset, nodes[0].name.length));
+
+    //Rebuild the categories; a new child is always the last one of its parent
+    vector<Node*> nodeAt(header.nodeCount);
+    nodeAt[0] = libTree->getRoot();
+    for (uint32_t i = 1; i < header.nodeCount; i++) {
+        Node* parent = nodeAt[nodes[i].parent];
+        libTree->insert(parent, string(strings + nodes[i].name.offset, nodes[i].name.length));
+        nodeAt[i] = parent->children[parent->children.size() - 1];
+    }
+
+    //Rebuild the books, recomputing the book counts once at the end
+    vector<Book*> bookAt(header.bookCount);
+    libTree->beginBulkLoad();
+    for (uint32_t i = 0; i < header.bookCount; i++) {
+        const SnapshotBook& record = books[i];
+        bookAt[i] = bookPool.create(string(strings + record.title.offset, record.title.length),
+                             string(strings + record.author.offset, record.author.length),
+                             string(strings + record.isbn.offset, record.isbn.length),
+                             record.publicationYear, record.totalCopies, record.availableCopies, authorNames);
+        attachBook(nodeAt[record.node], bookAt[i]);
+    }
+    libTree->endBulkLoad();
+
+    //Rebuild the borrowers and the loans
+    vector<Borrower*> borrowerAt(header.borrowerCount);
+    for (uint32_t i = 0; i < header.borrowerCount; i++) {
+        const SnapshotBorrower& record = borrowerRecords[i];
+        borrowerAt[i] = borrowers.findOrCreate(string(strings + record.name.offset, record.name.length),
+                                               string(strings + record.id.offset, record.id.length));
+    }
+    for (uint32_t i = 0; i < header.bookLoanCount; i++) {
+        bookAt[bookLoans[i].book]->currentBorrowers.push_back(borrowerAt[bookLoans[i].borrower]);
+    }
+    for (uint32_t i = 0; i < header.borrowerLoanCount; i++) {
+        borrowerAt[borrowerLoans[i].borrower]->books_borrowed.push_back(bookAt[borrowerLoans[i].book]);
+    }
+    for (uint32_t i = 0; i < header.historyCount; i++) {
+        bookAt[history[i].book]->allBorrowers.push_back(borrowerAt[history[i].borrower]);
+    }
+
+    cout << header.bookCount << " books and " << header.borrowerCount << " borrowers have been loaded from: " << path << endl;
+    return true;
+}
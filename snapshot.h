@@ -0,0 +1,83 @@
+//============================================================================
+// Name         : snapshot.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : On-disk layout of a catalog snapshot (see snapshot.cpp)
+//============================================================================
+#ifndef _SNAPSHOT_H
+#define _SNAPSHOT_H
+
+#include <cstdint>
+
+//A snapshot file is a header followed by fixed-size record arrays and a string table.
+//Records refer to each other by index and to text by (offset, length) into the string table.
+//Integers are stored in the byte order of the machine that wrote the file.
+
+static const char SNAPSHOT_MAGIC[8] = {'L', 'C', 'M', 'S', 'S', 'N', 'A', 'P'};
+static const uint32_t SNAPSHOT_VERSION = 1;
+static const uint32_t SNAPSHOT_NO_PARENT = 0xFFFFFFFFu;
+
+//Text stored in the string table
+struct SnapshotString
+{
+	uint32_t offset;
+	uint32_t length;
+};
+
+//A category; nodes are stored in pre-order, so a parent always comes before its children
+struct SnapshotNode
+{
+	uint32_t parent;			//index of the parent node, SNAPSHOT_NO_PARENT for the root
+	SnapshotString name;
+};
+
+//A book and the node that holds it
+struct SnapshotBook
+{
+	SnapshotString title;
+	SnapshotString author;
+	SnapshotString isbn;
+	int32_t publicationYear;
+	int32_t totalCopies;
+	int32_t availableCopies;
+	uint32_t node;
+};
+
+//A borrower, in registration order
+struct SnapshotBorrower
+{
+	SnapshotString name;
+	SnapshotString id;
+};
+
+//A book/borrower pair; used for the current borrowers of books, the books of borrowers and borrowing history
+struct SnapshotLink
+{
+	uint32_t book;
+	uint32_t borrower;
+};
+
+struct SnapshotHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t nodeCount;
+	uint32_t bookCount;
+	uint32_t borrowerCount;
+	uint32_t bookLoanCount;			//links in Book::currentBorrowers order
+	uint32_t borrowerLoanCount;		//links in Borrower::books_borrowed order
+	uint32_t historyCount;			//links in Book::allBorrowers order
+	uint32_t reserved;
+	uint64_t nodesOffset;
+	uint64_t booksOffset;
+	uint64_t borrowersOffset;
+	uint64_t bookLoansOffset;
+	uint64_t borrowerLoansOffset;
+	uint64_t historyOffset;
+	uint64_t stringsOffset;
+	uint64_t stringsSize;
+};
+
+#endif
@@ -0,0 +1,234 @@
+//============================================================================
+// Name         : stats.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Latency histograms of the commands and the stats command output
+//============================================================================
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include "stats.h"
+
+using namespace std;
+
+//Constructor with every bucket empty
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+//Function to return the bucket of a value
+int LatencyHistogram::bucketOf(unsigned long long value) {
+    //Values below SUB_BUCKETS have a bucket each
+    if (value < (unsigned long long)SUB_BUCKETS) {
+        return (int)value;
+    }
+    //Otherwise the highest bit picks the power of two and the next 4 bits the sub-bucket
+    int exponent = 63 - __builtin_clzll(value);
+    int sub = (int)((value >> (exponent - 4)) & (SUB_BUCKETS - 1));
+    int bucket = (exponent - 3) * SUB_BUCKETS + sub;
+    return bucket < BUCKETS ? bucket : BUCKETS - 1;
+}
+
+//Function to return the middle of the values that fall in a bucket
+unsigned long long LatencyHistogram::valueOf(int bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return (unsigned long long)bucket;
+    }
+    int exponent = bucket / SUB_BUCKETS + 3;
+    unsigned long long width = 1ULL << (exponent - 4);
+    unsigned long long low = (unsigned long long)(SUB_BUCKETS + bucket % SUB_BUCKETS) << (exponent - 4);
+    return low + width / 2;
+}
+
+//Function to add a value to the histogram
+void LatencyHistogram::record(unsigned long long nanoseconds) {
+    //Relaxed order is enough: the counters are only read for reports
+    buckets[bucketOf(nanoseconds)].fetch_add(1, memory_order_relaxed);
+    samples.fetch_add(1, memory_order_relaxed);
+    sum.fetch_add(nanoseconds, memory_order_relaxed);
+    unsigned long long largest = maximum.load(memory_order_relaxed);
+    while (nanoseconds > largest && !maximum.compare_exchange_weak(largest, nanoseconds, memory_order_relaxed)) {
+    }
+}
+
+//Function to forget every value
+void LatencyHistogram::reset() {
+    for (int i = 0; i < BUCKETS; i++) {
+        buckets[i].store(0, memory_order_relaxed);
+    }
+    samples.store(0, memory_order_relaxed);
+    sum.store(0, memory_order_relaxed);
+    maximum.store(0, memory_order_relaxed);
+}
+
+//Function to return the number of values recorded
+unsigned long long LatencyHistogram::count() const {
+    return samples.load(memory_order_relaxed);
+}
+
+//Function to return the mean of the values
+double LatencyHistogram::mean() const {
+    unsigned long long n = count();
+    return n == 0 ? 0 : (double)sum.load(memory_order_relaxed) / n;
+}
+
+//Function to return the value below which p percent of the values are
+unsigned long long LatencyHistogram::percentile(double p) const {
+    unsigned long long n = count();
+    if (n == 0) {
+        return 0;
+    }
+    //Walk the buckets until the rank of the percentile is reached
+    unsigned long long rank = (unsigned long long)(p / 100.0 * n + 0.999999);
+    if (rank == 0) rank = 1;
+    unsigned long long seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += buckets[i].load(memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(valueOf(i), max());
+        }
+    }
+    return max();
+}
+
+//Function to return the largest value recorded
+unsigned long long LatencyHistogram::max() const {
+    return maximum.load(memory_order_relaxed);
+}
+
+//Function to record the time since the timer started, once
+void ScopedLatency::stop() {
+    if (histogram) {
+        histogram->record((unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        histogram = nullptr;
+    }
+}
+
+//Constructor with no histogram and no dump
+Stats::Stats() : dumpSeconds(0), dumping(false) {}
+
+//Destructor to stop the dumper and deallocate the histograms when the program ends
+Stats::~Stats() {
+    stopDump();
+    for (int i = 0; i < histograms.capacity(); i++) {
+        if (histograms.occupied(i)) {
+            delete histograms.valueAt(i);
+        }
+    }
+}
+
+//Function to return the statistics of the program
+Stats& Stats::instance() {
+    static Stats stats;
+    return stats;
+}
+
+//Function to return the histogram of a name, creating it the first time
+LatencyHistogram* Stats::histogram(const string& name) {
+    lock_guard<mutex> guard(lock);
+    LatencyHistogram** found = histograms.find(name);
+    if (found) {
+        return *found;
+    }
+    LatencyHistogram* created = new LatencyHistogram();
+    histograms.insert(name, created);
+    return created;
+}
+
+//Function to print every histogram that has values, in name order (latencies in microseconds)
+void Stats::print(ostream& out) {
+    vector<string> names;
+    vector<LatencyHistogram*> entries;
+    {
+        lock_guard<mutex> guard(lock);
+        for (int i = 0; i < histograms.capacity(); i++) {
+            if (histograms.occupied(i) && histograms.valueAt(i)->count() > 0) {
+                names.push_back(histograms.keyAt(i));
+            }
+        }
+        sort(names.begin(), names.end());
+        for (size_t i = 0; i < names.size(); i++) {
+            entries.push_back(*histograms.find(names[i]));
+        }
+    }
+    if (names.empty()) {
+        out << "No statistics have been recorded yet." << endl;
+        return;
+    }
+
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    out << fixed << setprecision(1);
+    out << left << setw(28) << "name (us)" << right << setw(10) << "count" << setw(12) << "mean" << setw(12) << "p50"
+        << setw(12) << "p90" << setw(12) << "p99" << setw(12) << "p99.9" << setw(12) << "max" << endl;
+    for (size_t i = 0; i < names.size(); i++) {
+        const LatencyHistogram* h = entries[i];
+        out << left << setw(28) << names[i] << right << setw(10) << h->count() << setw(12) << h->mean() / 1e3
+            << setw(12) << h->percentile(50) / 1e3 << setw(12) << h->percentile(90) / 1e3 << setw(12) << h->percentile(99) / 1e3
+            << setw(12) << h->percentile(99.9) / 1e3 << setw(12) << h->max() / 1e3 << endl;
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+//Function to forget every value recorded so far
+void Stats::reset() {
+    lock_guard<mutex> guard(lock);
+    for (int i = 0; i < histograms.capacity(); i++) {
+        if (histograms.occupied(i)) {
+            histograms.valueAt(i)->reset();
+        }
+    }
+}
+
+//Function to start appending the statistics to a file every given number of seconds
+bool Stats::startDump(const string& path, int seconds) {
+    //Check that the file can be written before starting the dumper
+    ofstream test(path.c_str(), ios::app);
+    if (!test || seconds <= 0) {
+        return false;
+    }
+    test.close();
+
+    stopDump();
+    lock_guard<mutex> guard(lock);
+    dumpPath = path;
+    dumpSeconds = seconds;
+    dumping = true;
+    dumper = thread(&Stats::dumpLoop, this);
+    return true;
+}
+
+//Function to stop the periodic dump
+void Stats::stopDump() {
+    {
+        lock_guard<mutex> guard(lock);
+        dumping = false;
+    }
+    wakeDumper.notify_all();
+    if (dumper.joinable()) {
+        dumper.join();
+    }
+}
+
+//Function run by the dumper thread: wait dumpSeconds, then append the statistics with a timestamp
+void Stats::dumpLoop() {
+    unique_lock<mutex> guard(lock);
+    while (dumping) {
+        if (wakeDumper.wait_for(guard, chrono::seconds(dumpSeconds), [this]() { return !dumping; })) {
+            break;
+        }
+        string path = dumpPath;
+        //print takes the lock itself
+        guard.unlock();
+        ofstream out(path.c_str(), ios::app);
+        out << "# " << (long long)time(nullptr) << endl;
+        print(out);
+        out << endl;
+        guard.lock();
+    }
+}
@@ -0,0 +1,100 @@
+//============================================================================
+// Name         : stats.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : header file for stats.cpp
+//============================================================================
+#ifndef _STATS_H
+#define _STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include "myhashmap.h"
+
+//Latency histogram with HDR-style buckets: 16 linear sub-buckets per power of two of nanoseconds, so a value is
+//known to within 1/16 (about 6%) from 1 ns to hundreds of years in a fixed 8 KB. Recording is lock-free.
+class LatencyHistogram
+{
+	private:
+		static const int SUB_BUCKETS = 16;
+		static const int BUCKETS = 61 * SUB_BUCKETS;	//values below 16 are exact, then 60 powers of two
+
+		std::atomic<unsigned long long> buckets[BUCKETS];
+		std::atomic<unsigned long long> samples;	//number of values recorded
+		std::atomic<unsigned long long> sum;		//sum of the values recorded (ns)
+		std::atomic<unsigned long long> maximum;	//largest value recorded (ns)
+
+		static int bucketOf(unsigned long long value);	//Return the bucket of a value
+		static unsigned long long valueOf(int bucket);	//Return the middle of the values of a bucket
+
+	public:
+		LatencyHistogram();
+
+		void record(unsigned long long nanoseconds);	//add a value
+		void reset();									//forget every value
+		unsigned long long count() const;				//number of values recorded
+		double mean() const;							//mean of the values (ns), 0 if none
+		unsigned long long percentile(double p) const;	//value (ns) below which p percent of the values are, 0 if none
+		unsigned long long max() const;					//largest value (ns)
+};
+
+//Times a scope (or up to stop()) and records the latency in a histogram
+class ScopedLatency
+{
+	private:
+		LatencyHistogram* histogram;		//nullptr once stopped
+		std::chrono::steady_clock::time_point start;
+		ScopedLatency(const ScopedLatency&);
+		ScopedLatency& operator=(const ScopedLatency&);
+	public:
+		explicit ScopedLatency(LatencyHistogram* histogram) : histogram(histogram), start(std::chrono::steady_clock::now()) {}
+		~ScopedLatency() { stop(); }
+		void stop();						//record the time since construction (only the first call records)
+};
+
+//Named latency histograms of the commands and their phases, with an optional periodic dump to a file
+class Stats
+{
+	private:
+		std::mutex lock;									//guards histograms and the dump settings
+		MyHashMap<std::string, LatencyHistogram*> histograms;	//name -> histogram (deleted only when the program ends, so pointers stay valid)
+		std::thread dumper;									//writes the histograms to dumpPath every dumpSeconds
+		std::condition_variable wakeDumper;					//signalled to stop the dumper
+		std::string dumpPath;
+		int dumpSeconds;
+		bool dumping;										//true while the dumper runs
+
+		Stats();
+		~Stats();
+		void dumpLoop();									//body of the dumper thread
+
+	public:
+		static Stats& instance();							//the statistics of the program
+
+		LatencyHistogram* histogram(const std::string& name);	//return the histogram of name, creating it if needed
+		void print(std::ostream& out);						//print count, mean and percentiles of every histogram
+		void reset();										//forget every value recorded so far
+		bool startDump(const std::string& path, int seconds);	//append the statistics to path every seconds, return false if it cannot be opened
+		void stopDump();									//stop the periodic dump
+};
+
+//Instrumentation macros: STATS_START(timer, "name") times from here to STATS_STOP(timer) or the end of the scope.
+//Without LCMS_STATS they expand to nothing, so a build without statistics has no instrumentation at all.
+#ifdef LCMS_STATS
+#define STATS_START(timer, name) \
+	static LatencyHistogram* const timer##Histogram = Stats::instance().histogram(name); \
+	ScopedLatency timer(timer##Histogram)
+#define STATS_STOP(timer) timer.stop()
+#else
+#define STATS_START(timer, name) ((void)0)
+#define STATS_STOP(timer) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,77 @@
+//============================================================================
+// Name         : stringpool.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Pool that stores each distinct string once (string interning)
+//============================================================================
+#include <cstring>
+#include "stringpool.h"
+
+//Function to compare the characters of two keys
+bool InternKey::operator==(const InternKey& other) const {
+    return size == other.size && (size == 0 || memcmp(data, other.data, size) == 0);
+}
+
+//Function to hash the characters of a key (FNV-1a)
+std::size_t InternKeyHash::operator()(const InternKey& key) const {
+    std::size_t h = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < key.size; i++){
+        h = (h ^ (unsigned char)key.data[i]) * 1099511628211ULL;
+    }
+    return h;
+}
+
+//Constructor
+StringPool::StringPool(){
+}
+
+//Deconstructor
+StringPool::~StringPool(){
+    //Deallocate every pooled string
+    for (int i = 0; i < strings.size(); i++){
+        delete strings[i];
+    }
+}
+
+//Function to find the id of a string, adding the string to the pool if it is not there yet
+unsigned int StringPool::intern(const char* data, std::size_t size){
+    //Look the characters up without copying them
+    InternKey key = {data, size};
+    unsigned int* id = ids.find(key);
+    if (id){
+        return *id;
+    }
+    //Copy the string into the pool; the key refers to the pooled copy, which never moves
+    std::string* text = new std::string(data, size);
+    unsigned int newId = strings.size();
+    strings.push_back(text);
+    InternKey pooledKey = {text->data(), text->size()};
+    ids.insert(pooledKey, newId);
+    return newId;
+}
+
+//Function to find the id of a string, adding the string to the pool if it is not there yet
+unsigned int StringPool::intern(const std::string& text){
+    return intern(text.data(), text.size());
+}
+
+//Function to return the string with the given id
+const std::string& StringPool::str(unsigned int id) const {
+    return *strings[id];
+}
+
+//Function to delete every pooled string
+void StringPool::clear(){
+    ids.clear();
+    for (int i = 0; i < strings.size(); i++){
+        delete strings[i];
+    }
+    strings.clear();
+}
+
+//Function to return the number of distinct strings
+int StringPool::size() const {
+    return strings.size();
+}
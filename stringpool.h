@@ -0,0 +1,52 @@
+//============================================================================
+// Name         : stringpool.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : header file for stringpool.cpp
+//============================================================================
+#ifndef _STRINGPOOL_H
+#define _STRINGPOOL_H
+
+#include <cstddef>
+#include <string>
+#include "myvector.h"
+#include "myhashmap.h"
+
+//Key of the pool: a view of the characters of a pooled string (or of the string being looked up)
+struct InternKey
+{
+	const char* data;
+	std::size_t size;
+	bool operator==(const InternKey& other) const;
+};
+
+//Hash function object for InternKey
+struct InternKeyHash
+{
+	std::size_t operator()(const InternKey& key) const;
+};
+
+//Pool that stores each distinct string once and refers to it by a compact id
+class StringPool
+{
+	private:
+		MyVector<std::string*> strings;						//id -> pooled string (owned, never moves once added)
+		MyHashMap<InternKey, unsigned int, InternKeyHash> ids;	//pooled string -> id
+
+		StringPool(const StringPool&);						//the pool owns its strings, so it cannot be copied
+		StringPool& operator=(const StringPool&);
+
+	public:
+		StringPool();
+		~StringPool();										//deletes every pooled string
+
+		unsigned int intern(const char* data, std::size_t size);	//return the id of the string, adding it to the pool if needed
+		unsigned int intern(const std::string& text);		//return the id of the string, adding it to the pool if needed
+		const std::string& str(unsigned int id) const;		//return the string with the given id
+		void clear();										//delete every pooled string (their ids are no longer valid)
+		int size() const;									//return number of distinct strings
+};
+
+#endif
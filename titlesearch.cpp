@@ -0,0 +1,207 @@
+//============================================================================
+// Name         : titlesearch.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Trigram index for case-insensitive substring search over titles
+//============================================================================
+#include <algorithm>
+#include <vector>
+#include "titlesearch.h"
+using namespace std;
+
+//Minimum number of document ids before removed documents are purged from the postings
+static const int COMPACT_MIN_DOCS = 1024;
+
+//Function to lower-case an ASCII letter (other bytes, including UTF-8 sequences, are kept)
+static inline unsigned char lowerChar(unsigned char c){
+    return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+//Function to pack the lower-cased characters text[i..i+2] into a trigram key
+static inline unsigned int trigramAt(const string& text, size_t i){
+    return ((unsigned int)lowerChar(text[i]) << 16) | ((unsigned int)lowerChar(text[i + 1]) << 8) | lowerChar(text[i + 2]);
+}
+
+//Function to find a lower-case needle in text ignoring case, starting at from; return string::npos if absent
+static size_t findIgnoreCase(const string& text, const string& needle, size_t from){
+    if (needle.size() > text.size()){
+        return string::npos;
+    }
+    for (size_t i = from; i + needle.size() <= text.size(); i++){
+        size_t j = 0;
+        while (j < needle.size() && lowerChar(text[i + j]) == (unsigned char)needle[j]){
+            j++;
+        }
+        if (j == needle.size()){
+            return i;
+        }
+    }
+    return string::npos;
+}
+
+//Match found by a search, ordered by how well it matches
+struct TitleMatch
+{
+    int rank;           //0 whole title, 1 prefix, 2 start of a word, 3 elsewhere
+    Book* book;
+};
+
+//Constructor
+TitleSearchIndex::TitleSearchIndex(){
+    liveDocs = 0;
+}
+
+//Function to add the trigrams of the title of a book to the index
+void TitleSearchIndex::add(Book* book){
+    //Give the book the next document id; ids only grow, so every posting list stays sorted
+    int doc = docs.size();
+    docs.push_back(book);
+    book->titleDoc = doc;
+    liveDocs++;
+
+    const string& title = book->title;
+    for (size_t i = 0; i + 3 <= title.size(); i++){
+        MyVector<int>& list = postings[trigramAt(title, i)];
+        //A trigram that occurs twice in the title is only listed once
+        if (list.empty() || list[list.size() - 1] != doc){
+            list.push_back(doc);
+        }
+    }
+}
+
+//Function to drop a book from the index
+void TitleSearchIndex::remove(Book* book){
+    //If the book is not indexed, then there is nothing to do
+    if (book->titleDoc < 0){
+        return;
+    }
+    //Only mark the document as removed; its ids are purged from the postings in bulk
+    docs[book->titleDoc] = nullptr;
+    book->titleDoc = -1;
+    liveDocs--;
+    if (docs.size() >= COMPACT_MIN_DOCS && liveDocs * 2 < docs.size()){
+        compact();
+    }
+}
+
+//Function to rebuild the index from the documents that are not removed
+void TitleSearchIndex::compact(){
+    MyVector<Book*> live;
+    live.reserve(liveDocs);
+    for (int i = 0; i < docs.size(); i++){
+        if (docs[i]){
+            live.push_back(docs[i]);
+        }
+    }
+    postings.clear();
+    docs.clear();
+    liveDocs = 0;
+    for (int i = 0; i < live.size(); i++){
+        add(live[i]);
+    }
+}
+
+//Function to remove every book from the index
+void TitleSearchIndex::clear(){
+    for (int i = 0; i < docs.size(); i++){
+        if (docs[i]){
+            docs[i]->titleDoc = -1;
+        }
+    }
+    postings.clear();
+    docs.clear();
+    liveDocs = 0;
+}
+
+//Function to find the books whose title contains the fragment
+int TitleSearchIndex::search(const string& fragment, int limit, MyVector<Book*>& matches) const {
+    //Lower-case the fragment once
+    string needle(fragment);
+    for (size_t i = 0; i < needle.size(); i++){
+        needle[i] = lowerChar(needle[i]);
+    }
+    if (needle.empty()){
+        return 0;
+    }
+
+    //Collect the candidate documents
+    vector<int> candidates;
+    if (needle.size() < 3){
+        //A fragment shorter than a trigram can only be checked against every title
+        for (int i = 0; i < docs.size(); i++){
+            if (docs[i]){
+                candidates.push_back(i);
+            }
+        }
+    } else {
+        //Every trigram of the fragment must occur in the title; start from the shortest posting list
+        vector<const MyVector<int>*> lists;
+        for (size_t i = 0; i + 3 <= needle.size(); i++){
+            const MyVector<int>* list = postings.find(trigramAt(needle, i));
+            if (!list){
+                return 0;
+            }
+            lists.push_back(list);
+        }
+        sort(lists.begin(), lists.end(), [](const MyVector<int>* a, const MyVector<int>* b){ return a->size() < b->size(); });
+        candidates.assign(lists[0]->begin(), lists[0]->end());
+        //Intersect with the longer lists by binary search, so their length barely matters
+        for (size_t k = 1; k < lists.size() && !candidates.empty(); k++){
+            if (lists[k] == lists[k - 1]){
+                continue;
+            }
+            const int* p = lists[k]->begin();
+            const int* e = lists[k]->end();
+            size_t kept = 0;
+            for (size_t c = 0; c < candidates.size() && p != e; c++){
+                p = lower_bound(p, e, candidates[c]);
+                if (p != e && *p == candidates[c]){
+                    candidates[kept++] = candidates[c];
+                }
+            }
+            candidates.resize(kept);
+        }
+    }
+
+    //Verify each candidate (the trigrams may occur apart from each other) and rank it
+    vector<TitleMatch> found;
+    for (size_t c = 0; c < candidates.size(); c++){
+        Book* book = docs[candidates[c]];
+        if (!book){
+            continue;
+        }
+        const string& title = book->title;
+        size_t pos = findIgnoreCase(title, needle, 0);
+        if (pos == string::npos){
+            continue;
+        }
+        int rank = 3;
+        if (pos == 0){
+            rank = title.size() == needle.size() ? 0 : 1;
+        } else {
+            //Look for an occurrence that starts a word
+            for (; pos != string::npos; pos = findIgnoreCase(title, needle, pos + 1)){
+                if (title[pos - 1] == ' ' || title[pos - 1] == '-' || title[pos - 1] == '(' || title[pos - 1] == '"'){
+                    rank = 2;
+                    break;
+                }
+            }
+        }
+        TitleMatch match = {rank, book};
+        found.push_back(match);
+    }
+
+    //Keep the best matches: better rank first, then shorter title, then alphabetical
+    size_t keep = min(found.size(), (size_t)(limit > 0 ? limit : 0));
+    partial_sort(found.begin(), found.begin() + keep, found.end(), [](const TitleMatch& a, const TitleMatch& b){
+        if (a.rank != b.rank) return a.rank < b.rank;
+        if (a.book->title.size() != b.book->title.size()) return a.book->title.size() < b.book->title.size();
+        return a.book->title < b.book->title;
+    });
+    for (size_t i = 0; i < keep; i++){
+        matches.push_back(found[i].book);
+    }
+    return found.size();
+}
@@ -0,0 +1,39 @@
+//============================================================================
+// Name         : titlesearch.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : header file for titlesearch.cpp
+//============================================================================
+#ifndef _TITLESEARCH_H
+#define _TITLESEARCH_H
+
+#include <string>
+#include "myvector.h"
+#include "myhashmap.h"
+#include "book.h"
+
+//Inverted index from the trigrams (three consecutive characters, case-insensitive)
+//of the titles to the books, for substring search over the titles
+class TitleSearchIndex
+{
+	private:
+		MyHashMap<unsigned int, MyVector<int> > postings;	//trigram -> ascending document ids of the titles that contain it
+		MyVector<Book*> docs;								//document id -> book (nullptr once the book is removed)
+		int liveDocs;										//number of documents that are not removed
+
+		void compact();										//renumber the live documents and rebuild the postings without the removed ones
+
+	public:
+		TitleSearchIndex();
+
+		void add(Book* book);								//index the title of a book
+		void remove(Book* book);							//drop a book from the index
+		void clear();										//remove every book
+		//find the books whose title contains fragment (ignoring case), fill matches with the best limit of them
+		//(exact title, then prefix, then start of a word, then elsewhere; shorter titles first) and return the number of matches
+		int search(const std::string& fragment, int limit, MyVector<Book*>& matches) const;
+};
+
+#endif
@@ -0,0 +1,171 @@
+//============================================================================
+// Name         : trace.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Chrome trace-event export of the phases of long commands
+//============================================================================
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <unistd.h>
+#include "trace.h"
+
+using namespace std;
+
+//Function to append a string to JSON text as a quoted, escaped string
+static void appendJsonString(string& out, const string& text) {
+    out += '"';
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += (char)c;
+        } else if (c < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += (char)c;
+        }
+    }
+    out += '"';
+}
+
+//Constructor with tracing disabled
+TraceLog::TraceLog() : active(false), origin(chrono::steady_clock::now()), dropped(0) {}
+
+//Destructor to write a trace that is still being recorded when the program ends
+TraceLog::~TraceLog() {
+    if (active.load()) {
+        stop();
+    }
+}
+
+//Function to return the trace of the program
+TraceLog& TraceLog::instance() {
+    static TraceLog trace;
+    return trace;
+}
+
+//Function to return a small id of the calling thread, so the trace viewer shows one row per thread
+int TraceLog::threadId() {
+    static atomic<int> nextId(1);
+    static thread_local int id = nextId.fetch_add(1);
+    return id;
+}
+
+//Function to start recording spans
+bool TraceLog::start(const string& path) {
+    //Check that the file can be written before recording anything
+    ofstream test(path.c_str());
+    if (!test) {
+        return false;
+    }
+    lock_guard<mutex> guard(lock);
+    this->path = path;
+    events.clear();
+    dropped = 0;
+    origin = chrono::steady_clock::now();
+    active.store(true);
+    return true;
+}
+
+//Function to stop recording and write the spans as a Chrome trace-event JSON file
+bool TraceLog::stop() {
+    active.store(false);
+    lock_guard<mutex> guard(lock);
+    ofstream file(path.c_str());
+    if (!file) {
+        return false;
+    }
+    int pid = (int)getpid();
+    file << fixed << setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << endl;
+    //Name the process so the viewer shows "lcms" instead of the pid
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":0,\"args\":{\"name\":\"lcms\"}}";
+    for (size_t i = 0; i < events.size(); i++) {
+        const TraceEvent& event = events[i];
+        string name;
+        appendJsonString(name, event.name);
+        file << "," << endl << "{\"name\":" << name << ",\"cat\":\"lcms\",\"ph\":\"X\",\"ts\":" << event.start
+             << ",\"dur\":" << event.duration << ",\"pid\":" << pid << ",\"tid\":" << event.thread
+             << ",\"args\":{" << event.args << "}}";
+    }
+    file << endl << "]}" << endl;
+    events.clear();
+    events.shrink_to_fit();
+    if (dropped > 0) {
+        fprintf(stderr, "Warning: %d trace spans were dropped (at most %d are kept).\n", dropped, MAX_EVENTS);
+    }
+    return (bool)file;
+}
+
+//Function to return the microseconds since the trace started
+double TraceLog::now() const {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - origin).count() / 1e3;
+}
+
+//Function to keep a finished span
+void TraceLog::add(TraceEvent& event) {
+    lock_guard<mutex> guard(lock);
+    if (!active.load(memory_order_relaxed)) {
+        return;
+    }
+    if ((int)events.size() >= MAX_EVENTS) {
+        dropped++;
+        return;
+    }
+    events.push_back(TraceEvent());
+    events.back().name = event.name;
+    events.back().start = event.start;
+    events.back().duration = event.duration;
+    events.back().thread = event.thread;
+    events.back().args.swap(event.args);
+}
+
+//Constructor to start a span if tracing is enabled
+TraceSpan::TraceSpan(const char* name) : name(name), start(0), open(TraceLog::enabled()) {
+    if (open) {
+        start = TraceLog::instance().now();
+    }
+}
+
+//Function to add a number shown with the span
+void TraceSpan::arg(const char* key, long long value) {
+    if (!open) {
+        return;
+    }
+    if (!args.empty()) args += ',';
+    appendJsonString(args, key);
+    args += ':';
+    args += to_string(value);
+}
+
+//Function to add a text shown with the span
+void TraceSpan::arg(const char* key, const string& value) {
+    if (!open) {
+        return;
+    }
+    if (!args.empty()) args += ',';
+    appendJsonString(args, key);
+    args += ':';
+    appendJsonString(args, value);
+}
+
+//Function to finish the span and hand it to the trace
+void TraceSpan::end() {
+    if (!open) {
+        return;
+    }
+    open = false;
+    TraceLog& trace = TraceLog::instance();
+    TraceEvent event;
+    event.name = name;
+    event.start = start;
+    event.duration = trace.now() - start;
+    event.thread = TraceLog::threadId();
+    event.args.swap(args);
+    trace.add(event);
+}
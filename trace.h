@@ -0,0 +1,77 @@
+//============================================================================
+// Name         : trace.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : header file for trace.cpp
+//============================================================================
+#ifndef _TRACE_H
+#define _TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//A finished span: a "complete" event of the Chrome trace-event format
+struct TraceEvent
+{
+	const char* name;			//static name of the phase, e.g. "import.merge"
+	double start;				//microseconds since the trace started
+	double duration;			//microseconds
+	int thread;					//small id of the thread that ran the phase
+	std::string args;			//JSON members shown with the event, e.g. "\"books\":120000"
+};
+
+//Collects spans while enabled and writes them as a Chrome/Perfetto JSON trace (open it in chrome://tracing
+//or ui.perfetto.dev). While disabled, a span costs one relaxed atomic load.
+class TraceLog
+{
+	private:
+		static const int MAX_EVENTS = 1000000;		//spans beyond this are dropped, so a forgotten trace cannot use all memory
+
+		std::atomic<bool> active;
+		std::mutex lock;							//guards events and path
+		std::vector<TraceEvent> events;
+		std::string path;
+		std::chrono::steady_clock::time_point origin;	//time 0 of the trace
+		int dropped;								//spans not kept because of MAX_EVENTS
+
+		TraceLog();
+		~TraceLog();
+
+	public:
+		static TraceLog& instance();				//the trace of the program
+		static bool enabled()						//true while a trace is being recorded
+		{
+			return instance().active.load(std::memory_order_relaxed);
+		}
+		static int threadId();						//small id of the calling thread (1 for the first thread that asks)
+
+		bool start(const std::string& path);		//start recording spans for path, return false if it cannot be written
+		bool stop();								//write the spans to the file and stop recording, return false if it fails
+		double now() const;							//microseconds since the trace started
+		void add(TraceEvent& event);				//keep a finished span
+};
+
+//Records the time from construction to end() (or the end of the scope) as a span, if tracing is enabled
+class TraceSpan
+{
+	private:
+		const char* name;
+		double start;
+		bool open;									//true until the span is ended (always false while tracing is disabled)
+		std::string args;
+		TraceSpan(const TraceSpan&);
+		TraceSpan& operator=(const TraceSpan&);
+	public:
+		explicit TraceSpan(const char* name);
+		~TraceSpan() { end(); }
+		void arg(const char* key, long long value);	//add a number shown with the span
+		void arg(const char* key, const std::string& value);	//add a text shown with the span
+		void end();									//finish the span (only the first call records it)
+};
+
+#endif
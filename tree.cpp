@@ -9,9 +9,11 @@
 #include <iostream>
 #include<fstream>
 #include<string>
+#include <cstring>
 #include "myvector.h"
 #include "book.h"
 #include "tree.h"
+#include "trace.h"
 using namespace std;
 
 //Constructor
@@ -19,25 +21,22 @@ Node::Node(string name){
     this->name = name; //Set the name of the node 
     this->bookCount = 0; //Initialize bookCount to 0
     this->parent = NULL; //Set parent to NULL
+    this->childIndex = NULL; //Children are scanned linearly until the node becomes wide
+    this->id = 0; //The tree numbers the node when it is inserted
+    this->flatIndex = -1; //The tree places the node when it builds its layout
 }
 
 //Function to obtain the category path for node 
-string Node::getCategory(Node* node){
-    //Base case
-    //If the current node is a root, then return its name
-    if(!node->parent){
-        return node->name;
-    }
-    //Recursively call getCategory function to move to the current node's parent, while printing the name of the current node
-    return node->parent->getCategory(node->parent) + "/" + node->name;
+const string& Node::getCategory(Node* node){
+    //The tree keeps the full path of every node, so it is not rebuilt from the parents
+    return node->category;
 }
 
 //Deconstructor 
 Node::~Node(){
-    //Iterate through each child node and deallocate the memory for them
-    for (int i = 0; i < children.size(); i++){
-        delete children[i];
-    }
+    //Children live in the tree's node pool and are released by the tree
+    //Deallocate the child index if the node had one
+    delete childIndex;
 }
 
 //==========================================================
@@ -45,13 +44,20 @@ Node::~Node(){
 //Constructor 
 Tree::Tree(string rootName){
     //Initialize the root with the provided name
-    root = new Node(rootName);
+    root = nodePool.create(rootName);
+    root->category = rootName;
+    //The root is node 0
+    nextNodeId = 1;
+    //Book counts are maintained on every change until a bulk load starts
+    bulkLoading = false;
+    //The layout is built the first time a traversal needs it
+    flatValid = false;
 }
 
 //Deconstructor 
 Tree::~Tree(){
-    //Delete the node to delete the whole tree
-    delete root;
+    //Release every node of the tree at once
+    nodePool.releaseAll();
 }
 
 //Getter function for the root node 
@@ -74,23 +80,61 @@ bool Tree::isLastChild(Node *ptr){
 //Function to insert a new child with the specific node to the given parent node 
 void Tree::insert(Node* node, string name){
     //Create a node called child with the specified name 
-    Node* child = new Node(name);
+    Node* child = nodePool.create(name);
     //Set its parent to the specific node 
     child->parent = node;
+    //Give the child the next node id
+    child->id = nextNodeId++;
+    //Keep the full path of the child and index it (the first node with a path wins, as in a walk from the root)
+    child->category = node->category + "/" + name;
+    pathIndex.insert(pathKey(child), child);
     //Add the child to the parent's children vector 
     node->children.push_back(child);
+    //The layout no longer has every node
+    flatValid = false;
+
+    //If the node already has a child index, then add the child to it
+    if (node->childIndex){
+        node->childIndex->insert(name, child);
+    } else if (node->children.size() > Node::CHILD_INDEX_THRESHOLD){
+        //If the node just became wide, then index all of its children (the first child with a name wins, as in a linear scan)
+        node->childIndex = new MyHashMap<string, Node*>();
+        node->childIndex->reserve(node->children.size() * 2);
+        for (int i = 0; i < node->children.size(); i++){
+            node->childIndex->insert(node->children[i]->name, node->children[i]);
+        }
+    }
 }
 
 //Function to remove a specific child node 
 void Tree::remove(Node* node, string child_name){
-    //Iterate through each child to find the child node with the provided name
+    //Find the child with the provided name
+    Node* child = getChild(node, child_name);
+    if (child == NULL){
+        return;
+    }
+    //Iterate through each child to find the position of the child node
     for (int i = 0; i < node->children.size(); i++){
-        if (node->children[i]->name == child_name){
-            delete node->children[i]; //Deallocate the memory space for the specific child
-            node->children.erase(i); //Remove the pointer that points to the deleted node from the children vector
+        if (node->children[i] == child){
+            node->children.erase(i); //Remove the pointer that points to the child from the children vector
             break; //Stop
         }
     }
+    //If the node has a child index, then drop the child from it
+    if (node->childIndex){
+        node->childIndex->erase(child_name);
+        //If another child has the same name, then it becomes the one that is found
+        for (int i = 0; i < node->children.size(); i++){
+            if (node->children[i]->name == child_name){
+                node->childIndex->insert(child_name, node->children[i]);
+                break;
+            }
+        }
+    }
+    //Deallocate the memory space for the specific child and its descendants; if a sibling has the same name,
+    //then the paths of the subtree may also exist below it
+    releaseSubtree(child, getChild(node, child_name) != NULL);
+    flatValid = false;
 }
 
 //Function to check if the node is root or not 
@@ -100,109 +144,67 @@ bool Tree::isRoot(Node* node){
 }
 
 //Function to locate a ndoe based on the path 
-Node* Tree::getNode(string path) {
-    //Create a new node called current and set it to root 
-    Node* current = root;
-    //Set the position to 0
-    size_t pos = 0;
-    string categoryName;
-
-    //Loop through each category in the path by splitting with '/'
-    while ((pos = path.find('/')) != string::npos) {
-        //Get the name of the next category 
-        categoryName = path.substr(0, pos); 
-        //Set boolean variable called found to false 
-        bool found = false;
-
-        //Iterate and search through current node's children for matching
-        for (int i = 0; i < current->children.size(); i++) {
-            if (current->children[i]->name == categoryName) {
-                //Move to the child node that is fonud to be matching
-                current = current->children[i]; 
-                //Set found to be true because the node is found 
-                found = true;
-                //Stop looping
-                break;
-            }
-        }
-
-        //If the given category is not found, then return nullptr 
-        if (!found) return nullptr;
-
-        //Remove the category from the path 
-        path.erase(0, pos + 1);
-    }
+Node* Tree::getNode(const string& path) {
+    return getNode(path.data(), path.size());
+}
 
-    //If path is empty  
-    if (!path.empty()) {
-        bool found = false;
-        //Iterate through children of the current node to locate the last category
-        for (int i = 0; i < current->children.size(); i++) {
-            //If the name of the child matches path, then
-            if (current->children[i]->name == path) {
-                //Move to the child that is found to be matching 
-                current = current->children[i];
-                //Set found to be true 
-                found = true;
-                //Stop looping
-                break;
-            }
-        }
+//Function to locate a node based on a path given by its characters
+Node* Tree::getNode(const char* path, size_t size) {
+    //An empty path is the root
+    if (size == 0) return root;
 
-        //If the final category part cannot be found, then return nullptr
-        if (!found) return nullptr;
-    }
+    //A trailing '/' does not name another category ("A/" is "A")
+    if (path[size - 1] == '/') size--;
 
-    //Return the node 
-    return current;
+    //Look the whole path up at once, without copying it
+    InternKey key = {path, size};
+    Node** node = pathIndex.find(key);
+    //If the given category is not found, then return nullptr 
+    return node ? *node : nullptr;
 }
 
 //Function to create a new node based upon the given path
-Node* Tree::createNode(string path){
-    //Create a new node called current to start from the root 
+Node* Tree::createNode(const string& path){
+    //If the whole path exists, then return its node
+    InternKey key = {path.data(), path.size()};
+    Node** found = pathIndex.find(key);
+    if (found) return *found;
+
+    //Find the deepest category of the path that exists, trying the prefixes from the longest
     Node* current = root;
-    //Set the position for splitting path
-    size_t pos = 0;
-    string categoryName;
-    
-    //Use while loop to traverse each level in the path being splitted by '/'
-    while((pos = path.find('/')) != string::npos){
-        //Get the next category 
-        categoryName = path.substr(0, pos);
-        //Create a new node called childNode to get the child node with the matching name 
-        Node* childNode = getChild(current, categoryName);
-        
-        //If the child node does not exist, then
-        if (!childNode){
-            //Insert a new node 
-            insert(current, categoryName);
-            //Get referece to the new child node 
-            childNode = getChild(current, categoryName);
+    size_t start = 0;
+    for (size_t pos = path.rfind('/'); pos != string::npos; pos = pos == 0 ? string::npos : path.rfind('/', pos - 1)){
+        InternKey prefix = {path.data(), pos};
+        Node** ancestor = pathIndex.find(prefix);
+        if (ancestor){
+            current = *ancestor;
+            start = pos + 1;
+            break;
         }
-        
-        //Move to the child node for next level
-        current = childNode;
-        //Delete the processed parts from the given path 
-        path.erase(0, pos + 1);
     }
 
-    Node* childNode = getChild(current, path);
-    //If the child node does not exist, then
-    if (!childNode){
-        //Insert a new node 
-        insert(current, path);
-        //Obtain reference to the newly added child node
-        childNode = getChild(current, path);
+    //Insert the remaining categories, each one below the previous
+    while (true){
+        size_t pos = path.find('/', start);
+        size_t end = pos == string::npos ? path.size() : pos;
+        insert(current, path.substr(start, end - start));
+        //The new child is the last one of current
+        current = current->children[current->children.size() - 1];
+        if (pos == string::npos) break;
+        start = pos + 1;
     }
-        
-    current = childNode;
     //Return current
     return current;
 }
 
 //Function to return the child node with the specified name 
 Node* Tree::getChild(Node* ptr, string childname){
-    //Iterate through each child node
+    //If the node is wide, then look the child up in its index
+    if (ptr->childIndex){
+        Node** child = ptr->childIndex->find(childname);
+        return child ? *child : NULL;
+    }
+    //Otherwise iterate through each child node
     for (int i = 0; i < ptr->children.size(); i++){
         //If the name of the current node is same as the name of the child node, then it will return the pointer to that child node
         if (ptr->children[i]->name == childname){
@@ -215,80 +217,193 @@ Node* Tree::getChild(Node* ptr, string childname){
 
 //Function to update the book count for node and its parent 
 void Tree::updateBookCount(Node* ptr, int offset){
+    //During a bulk load the counts are recomputed at the end instead
+    if (bulkLoading){return;}
     //Adjust the bookCount with the provided offset 
     ptr->bookCount += offset;
     //Recursively call the function itself to update the parent's book count 
     if(ptr->parent != nullptr){updateBookCount(ptr->parent, offset);}
 }
 
-//Function to find the book with the specified title 
-Book* Tree::findBook(Node *node, string bookTitle){
-    //Iterate through books in the node using for loop
-    for (int i = 0; i < node->books.size(); i++){
-        //If the title matches 
-        if (node->books[i]->title == bookTitle){
-            return node->books[i]; //Return the book 
+//Function to display all the books inside the node and its children nodes 
+void Tree::printAll(Node *node, const StringPool& authorNames){
+    TraceSpan span("printAll");
+    span.arg("books", (long long)node->bookCount);
+    //The subtree of the node is a range of the layout, in the order a recursive walk would visit it
+    const MyVector<FlatNode>& nodes = layout();
+    for (int n = node->flatIndex; n < nodes[node->flatIndex].subtreeEnd; n++){
+        //Iterate through each book in the node 
+        Node* current = nodes[n].node;
+        for (int i = 0; i < current->books.size(); i++){
+            //Display each node by calling display function 
+            current->books[i]->display(authorNames);
         }
     }
-    //Recursively call the function itself to iterate through the child nodes 
-    for (int i = 0; i < node->children.size(); i++){
-        Book* book = findBook(node->children[i], bookTitle);
-        if (book != nullptr){return book;} //Return book 
-    }
-    //Return nullptr if book is not found
-    return nullptr;
 }
 
-//Function to remove the book from the specific node
-bool Tree::removeBook(Node* node,string bookTitle){
-    //Iterate through all the books in the node
-    for (int i = 0; i < node->books.size(); i++){
-        //If title matches
-        if (node->books[i]->title == bookTitle){
-            //Deallocate memory space for book 
-            delete node->books[i];
-            //Remove the book from the books vector 
-            node->books.erase(i);
-            //Return true if the book is successfully removed 
-            return true;
+//Function to export all the books in the node and its children
+int Tree::exportData(Node* node, CsvWriter& file, const StringPool& authorNames) {
+    //Scan the subtree in pre-order
+    const MyVector<FlatNode>& nodes = layout();
+    //Initialize the bookCount variable of type integer to 0
+    int bookCount = 0;
+    for (int n = node->flatIndex; n < nodes[node->flatIndex].subtreeEnd; n++) {
+        Node* current = nodes[n].node;
+        //The category is the path of the node below the root, as import expects it
+        InternKey category = pathKey(current);
+        //Iterate through each book in the node
+        for (int i = 0; i < current->books.size(); i++) {
+            Book* book = current->books[i];
+            file.writeField(book->title);
+            file.writeField(book->getAuthor(authorNames));
+            file.writeField(book->isbn);
+            file.writeInt(book->publication_year);
+            file.writeField(category.data, category.size);
+            file.writeInt(book->total_copies);
+            file.writeInt(book->available_copies);
+            file.endRecord();
+            bookCount++; //Increment the book cout by one
         }
     }
     
-    //Return false if the book is not found 
-    return false;
+    //Return the book count 
+    return bookCount;
 }
 
-//Function to display all the books inside the node and its children nodes 
-void Tree::printAll(Node *node){
-    //Iterate through each book in the node 
-    for (int i = 0; i < node->books.size(); i++){
-        //Display each node by calling display function 
-        node->books[i]->display();
+//Function to start a bulk load, during which book counts are left untouched
+void Tree::beginBulkLoad(){
+    bulkLoading = true;
+}
+
+//Function to finish a bulk load by recomputing every book count
+void Tree::endBulkLoad(){
+    TraceSpan span("import.bookCounts");
+    bulkLoading = false;
+    recountBooks(root);
+}
+
+//Function to check if a bulk load is in progress
+bool Tree::isBulkLoading(){
+    return bulkLoading;
+}
+
+//Function to recompute the book count of a node and its descendants from their books
+void Tree::recountBooks(Node* node){
+    const MyVector<FlatNode>& nodes = layout();
+    int first = node->flatIndex, last = nodes[first].subtreeEnd;
+    //Start every node with its own books
+    for (int n = first; n < last; n++){
+        nodes[n].node->bookCount = nodes[n].node->books.size();
     }
-    
-    //Recursively call the function itself to print all the books in the child nodes 
-    for (int i = 0; i < node->children.size(); i++){
-        printAll(node->children[i]);
+    //Walking backwards, every node is complete before it is added to its parent
+    for (int n = last - 1; n > first; n--){
+        nodes[nodes[n].parent].node->bookCount += nodes[n].node->bookCount;
     }
 }
 
-//Function to export all the books in the node and its children
-int Tree::exportData(Node* node, std::ofstream& file) {
-    //Initialize the bookCount variable of type integer to 0
-    int bookCount = 0;
-    //Iterate through each book in the node
-    for (int i = 0; i < node->books.size(); i++) {
-        file << node->books[i]->title << ", " << node->books[i]->author << ", " << node->books[i]->isbn << ", " << node->books[i]->publication_year << ", " << node->books[i]->total_copies << ", " << node->books[i]->available_copies << std::endl;
-        bookCount++; //Increment the book cout by one
+//Function to return the bound on the node ids
+unsigned int Tree::nodeIdLimit(){
+    return nextNodeId;
+}
+
+//Function to mark a node and all of its descendants by id
+void Tree::markSubtree(Node* node, MyVector<unsigned char>& marks){
+    const MyVector<FlatNode>& nodes = layout();
+    for (int n = node->flatIndex; n < nodes[node->flatIndex].subtreeEnd; n++){
+        marks[nodes[n].node->id] = 1;
     }
+}
 
-    //Iterate through each book in the child nodes 
-    for (int i = 0; i < node->children.size(); i++) {
-        bookCount += exportData(node->children[i], file); //Add count from the child nodes 
+//Function to return a node and every node below it to the node pool
+void Tree::releaseSubtree(Node* node, bool hasTwin){
+    //Walk the subtree itself rather than the layout, which may be stale and would cost a rebuild of the whole tree
+    //(use a stack instead of recursion so deep category paths cannot overflow the call stack)
+    MyVector<Node*> nodes_stack;
+    nodes_stack.push_back(node);
+    while (!nodes_stack.empty()){
+        Node* current = nodes_stack.back();
+        nodes_stack.pop_back();
+        for (int i = 0; i < current->children.size(); i++){
+            nodes_stack.push_back(current->children[i]);
+        }
+        //Drop the path of the node from the index (unless another node with the same path is the one indexed)
+        Node** indexed = pathIndex.find(pathKey(current));
+        if (indexed && *indexed == current){
+            pathIndex.erase(pathKey(current));
+            //If another node with the same path is left in the tree, then it becomes the one that is found
+            Node* survivor = hasTwin ? walkPath(pathKey(current)) : nullptr;
+            if (survivor){
+                pathIndex.insert(pathKey(survivor), survivor);
+            }
+        }
+        nodePool.destroy(current);
+    }
+}
+
+//Function to find a node by following its path from the root, taking the first child with each name (as getChild does)
+Node* Tree::walkPath(InternKey path){
+    if (path.size == 0) return root;
+    Node* current = root;
+    size_t start = 0;
+    while (current){
+        const char* slash = (const char*)memchr(path.data + start, '/', path.size - start);
+        size_t end = slash ? slash - path.data : path.size;
+        current = getChild(current, string(path.data + start, end - start));
+        if (!slash) break;
+        start = end + 1;
+    }
+    return current;
+}
+
+//Function to return the path of a node below the root (empty for the root), pointing into the category of the node
+InternKey Tree::pathKey(Node* node){
+    if (node == root){
+        InternKey key = {node->category.data(), 0};
+        return key;
+    }
+    //Skip the name of the root and the '/' after it
+    size_t skip = root->category.size() + 1;
+    InternKey key = {node->category.data() + skip, node->category.size() - skip};
+    return key;
+}
+
+//Function to return the flat layout of the tree, rebuilding it if a node was inserted or removed since it was built
+const MyVector<FlatNode>& Tree::layout(){
+    //Several readers may need the layout at once: the first one rebuilds it, the others wait for it
+    if (!flatValid.load(memory_order_acquire)){
+        lock_guard<mutex> guard(flatLock);
+        if (!flatValid.load(memory_order_relaxed)){
+            rebuildLayout();
+            flatValid.store(true, memory_order_release);
+        }
+    }
+    return flat;
+}
+
+//Function to lay the nodes out in DFS pre-order with the end of every subtree
+void Tree::rebuildLayout(){
+    flat.clear();
+    //Use a stack instead of recursion so deep category paths cannot overflow the call stack
+    MyVector<Node*> nodes_stack;
+    nodes_stack.push_back(root);
+    while (!nodes_stack.empty()){
+        Node* current = nodes_stack.back();
+        nodes_stack.pop_back();
+        current->flatIndex = flat.size();
+        FlatNode entry = {current, flat.size() + 1, current->parent ? current->parent->flatIndex : -1};
+        flat.push_back(entry);
+        //Push the children last to first, so the first child is visited first
+        for (int i = current->children.size() - 1; i >= 0; i--){
+            nodes_stack.push_back(current->children[i]);
+        }
+    }
+    //A subtree ends where the subtree of its last descendant ends; children come after their parent
+    for (int n = flat.size() - 1; n > 0; n--){
+        FlatNode& parent = flat[flat[n].parent];
+        if (flat[n].subtreeEnd > parent.subtreeEnd){
+            parent.subtreeEnd = flat[n].subtreeEnd;
+        }
     }
-    
-    //Return the book count 
-    return bookCount;
 }
 
 //Function to check if the tree is empty or not 
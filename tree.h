@@ -9,18 +9,30 @@
 #ifndef _TREE_H
 #define _TREE_H
 #include<string>
+#include <atomic>
+#include <mutex>
 #include "myvector.h"
+#include "myhashmap.h"
+#include "objectpool.h"
+#include "stringpool.h"
 #include "book.h"
+#include "csvwriter.h"
 using namespace std;
 
 class Node
 {
 	private:
 		string name;				//name of the Node
+		string category;			//full path of the node, e.g. "Library/Computer Science/Operating Systems" (set by the tree)
 		MyVector<Node*> children; 
     	MyVector<Book*> books;    
 		unsigned int bookCount;
 		Node* parent; 				//link to the parent 
+		unsigned int id;			//number of the node, unique within its tree (used as category id by the book columns)
+		MyHashMap<string, Node*>* childIndex;	//name -> child, built once the node has more than CHILD_INDEX_THRESHOLD children
+		int flatIndex;				//position of the node in the flat layout of its tree (valid while the layout is current)
+
+		static const int CHILD_INDEX_THRESHOLD = 8;	//narrow nodes are scanned linearly, wider ones use childIndex
 
 	public:
 		//constructor to create an empty node (category/sub-category)
@@ -29,20 +41,43 @@ class Node
 		// return category of a node (e.g. "Computer Science/Operating Systems")
 		// where "Operating Systems" is the name of node and "Computer Science"
 		// is the name of the name of the parent node.
-		string getCategory(Node* node);
+		const string& getCategory(Node* node);
 		
-		//deletes a node and clear/clean all its vectors
+		//deletes a node and clear/clean all its vectors (children are released by the Tree)
 		~Node();	
 
 	public:
 		friend class Tree;
 		friend class LCMS;
+		friend class BookColumns;
+};
+//==========================================================
+//Entry of the flat layout of a tree: the nodes in DFS pre-order, so the subtree of the node at
+//position i is the range [i, subtreeEnd) and a whole subtree is walked with a linear scan
+struct FlatNode
+{
+	Node* node;
+	int subtreeEnd;			//one past the position of the last descendant of node
+	int parent;				//position of the parent of node (-1 for the root)
 };
 //==========================================================
 class Tree
 {
 	private:
 		Node *root;				//root of the Tree
+		ObjectPool<Node> nodePool;	//storage of every node of the tree
+		unsigned int nextNodeId;	//id given to the next node that is inserted
+		bool bulkLoading;		//true between beginBulkLoad and endBulkLoad, while book counts are not maintained
+		MyVector<FlatNode> flat;	//nodes in DFS pre-order (children in vector order), rebuilt after the tree changes
+		std::atomic<bool> flatValid;	//false once a node was inserted or removed since the layout was built (the next scan rebuilds all of it)
+		std::mutex flatLock;		//serializes rebuilding the layout (readers share the tree, see LCMS::catalogLock)
+		MyHashMap<InternKey, Node*, InternKeyHash> pathIndex;	//path below the root -> node (keys point into Node::category)
+
+		void recountBooks(Node *node);		//recompute bookCount of a node and its descendants
+		void releaseSubtree(Node *node, bool hasTwin);	//return a node and all its descendants to the node pool (hasTwin: a sibling has its name)
+		void rebuildLayout();				//build flat from the current tree
+		InternKey pathKey(Node *node);		//return the path of a node below the root, as stored in pathIndex
+		Node* walkPath(InternKey path);		//find a node by walking its path from the root, nullptr if not found
 		
 	public:	 	//Required methods
 		Tree(string rootName);	
@@ -52,16 +87,21 @@ class Tree
 		void insert(Node* node,string name);			//insert a new child to a given node of of the tree
 		void remove(Node* node,string child_name);		//remove a specific child from a given node of the tree
 		bool isRoot(Node* node); 						//return true if the given node is the root, false otherwise
-		Node* getNode(string path);						//given a path (category/sub-category/sub-category/..) the method should return the Node if found, false otherwise
-		Node* createNode(string path);					//Create a node on a given path, e.g. category/sub-category/sub-category/...
+		Node* getNode(const string& path);				//given a path (category/sub-category/sub-category/..) the method should return the Node if found, false otherwise
+		Node* getNode(const char* path, size_t size);	//same as getNode for a path given by its characters
+		Node* createNode(const string& path);			//Create a node on a given path, e.g. category/sub-category/sub-category/...
 		Node* getChild(Node *ptr, string childname);	//given a node and name of a child, the method returns pointer to the child node if exist, nullptr otherwise
 		void updateBookCount(Node *ptr, int offset);	//update a books count by an offset e.g. +1/-1
-		Book* findBook(Node *node, string bookTitle);	//find a book in a given node, returns nullptr the book is not found
-		bool removeBook(Node* node,string bookTitle);   //remove a book from a given node
-		void printAll(Node *node);					    //printAll books of a node and it children recursively (see output of findAll command)
+		void printAll(Node *node, const StringPool& authorNames);	//printAll books of a node and it children recursively (see output of findAll command)
 		void print();			                        //Print all categories/sub-categories of a the tree. see output of list command (please use the implementation given below)
 		void print_helper(string padding, string pointer,Node *node); // helper method for the print() (please use the implementation given below)
-		int exportData(Node *node,ofstream& file);		//Export all books of a given node and its children to a specific file.
+		int exportData(Node *node,CsvWriter& file, const StringPool& authorNames);	//Export all books of a given node and its children to a specific file.
 		bool isEmpty();									//return true if the tree is empty false otherwise
+		void beginBulkLoad();							//stop maintaining book counts while many books are appended
+		void endBulkLoad();								//recompute every book count in a single pass and resume maintaining them
+		bool isBulkLoading();							//return true between beginBulkLoad and endBulkLoad
+		unsigned int nodeIdLimit();						//return a bound on the ids of the nodes (every id is smaller)
+		void markSubtree(Node *node, MyVector<unsigned char>& marks);	//set marks[id] to 1 for the node and its descendants (marks has nodeIdLimit entries)
+		const MyVector<FlatNode>& layout();				//return the flat layout, rebuilding it first if the tree changed
 };
 #endif
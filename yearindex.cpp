@@ -0,0 +1,150 @@
+//============================================================================
+// Name         : yearindex.cpp
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : Ordered index over publication years (sorted array with incremental merge)
+//============================================================================
+#include <algorithm>
+#include <functional>
+#include "yearindex.h"
+using namespace std;
+
+//Smallest delta that triggers a merge, so small catalogs do not merge on every change
+static const int MIN_MERGE_SIZE = 1024;
+//Largest number of appended entries left unsorted at the end of the delta (searches scan them linearly)
+static const int MAX_UNSORTED = 64;
+
+//Function to order entries by year and then by book address
+static inline bool entryLess(const YearEntry& a, const YearEntry& b){
+    if (a.year != b.year) return a.year < b.year;
+    return less<Book*>()(a.book, b.book);
+}
+
+//Function to order entries by year only (for seeking to a year)
+static inline bool yearLess(const YearEntry& a, int year){
+    return a.year < year;
+}
+
+//Constructor
+YearIndex::YearIndex(){
+    deltaSorted = 0;
+    removedCount = 0;
+}
+
+//Function to bring the entries appended to the delta into its sorted prefix
+void YearIndex::sortDelta(){
+    if (deltaSorted == delta.size()){
+        return;
+    }
+    //Sort the appended entries alone, then merge them with the prefix in linear time
+    sort(delta.begin() + deltaSorted, delta.end(), entryLess);
+    inplace_merge(delta.begin(), delta.begin() + deltaSorted, delta.end(), entryLess);
+    deltaSorted = delta.size();
+}
+
+//Function to merge the delta into the main array
+void YearIndex::merge(){
+    sortDelta();
+    MyVector<YearEntry> merged(main.size() + delta.size() - removedCount);
+    int i = 0, j = 0;
+    //Standard two-way merge that leaves out the removed entries
+    while (i < main.size() || j < delta.size()){
+        bool takeMain = j == delta.size() || (i < main.size() && !entryLess(delta[j], main[i]));
+        const YearEntry& entry = takeMain ? main[i++] : delta[j++];
+        if (!entry.removed){
+            merged.push_back(entry);
+        }
+    }
+    main = std::move(merged);
+    delta.clear();
+    deltaSorted = 0;
+    removedCount = 0;
+}
+
+//Function to find the live entry of a book among sorted entries
+YearEntry* YearIndex::findEntry(MyVector<YearEntry>& entries, int end, int year, Book* book){
+    YearEntry key = {year, false, book};
+    //Seek to the first entry of the book, then skip entries a previous book at the same address left behind
+    YearEntry* it = lower_bound(entries.begin(), entries.begin() + end, key, entryLess);
+    for (; it != entries.begin() + end && it->year == year && it->book == book; it++){
+        if (!it->removed){
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+//Function to add a book to the index
+void YearIndex::add(Book* book){
+    YearEntry entry = {book->publication_year, false, book};
+    delta.push_back(entry);
+    //Merge once the delta is large compared with the main array, so every entry is moved O(log n) times overall
+    if (delta.size() >= MIN_MERGE_SIZE && delta.size() * 8 >= main.size()){
+        merge();
+    } else if (delta.size() - deltaSorted >= MAX_UNSORTED){
+        //Sort the appended entries in batches here, so a search never has to change the index
+        sortDelta();
+    }
+}
+
+//Function to remove a book from the index
+void YearIndex::remove(Book* book, int year){
+    sortDelta();
+    YearEntry* entry = findEntry(delta, delta.size(), year, book);
+    if (!entry){
+        entry = findEntry(main, main.size(), year, book);
+    }
+    //If the book is not indexed under the year, then there is nothing to remove
+    if (!entry){
+        return;
+    }
+    //Only mark the entry; removed entries are dropped when the arrays are merged
+    entry->removed = true;
+    removedCount++;
+    if (removedCount >= MIN_MERGE_SIZE && removedCount * 2 >= main.size() + delta.size()){
+        merge();
+    }
+}
+
+//Function to remove every book from the index
+void YearIndex::clear(){
+    main.clear();
+    delta.clear();
+    deltaSorted = 0;
+    removedCount = 0;
+}
+
+//Function to list the books published within a range of years
+void YearIndex::search(int fromYear, int toYear, MyVector<Book*>& books) const{
+    //The few entries appended since the delta was last sorted are picked out and sorted on the side
+    MyVector<YearEntry> recent;
+    for (const YearEntry* it = delta.begin() + deltaSorted; it != delta.end(); it++){
+        if (it->year >= fromYear && it->year <= toYear){
+            recent.push_back(*it);
+        }
+    }
+    sort(recent.begin(), recent.end(), entryLess);
+
+    //Seek to the first year of the range in the sorted arrays, then scan the three of them in step
+    const YearEntry* deltaEnd = delta.begin() + deltaSorted;
+    const YearEntry* a = lower_bound(main.begin(), main.end(), fromYear, yearLess);
+    const YearEntry* b = lower_bound(delta.begin(), deltaEnd, fromYear, yearLess);
+    const YearEntry* c = recent.begin();
+    while (true){
+        const YearEntry* entry = nullptr;
+        if (a != main.end() && a->year <= toYear) entry = a;
+        if (b != deltaEnd && b->year <= toYear && (!entry || entryLess(*b, *entry))) entry = b;
+        if (c != recent.end() && (!entry || entryLess(*c, *entry))) entry = c;
+        if (!entry){
+            break;
+        }
+        if (entry == a) a++;
+        else if (entry == b) b++;
+        else c++;
+        if (!entry->removed){
+            books.push_back(entry->book);
+        }
+    }
+}
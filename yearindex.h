@@ -0,0 +1,47 @@
+//============================================================================
+// Name         : yearindex.h
+// Author       : Shota Matsumoto
+// Version      : 1.0
+// Date Created : 10/17/2026
+// Date Modified: 10/17/2026
+// Description  : header file for yearindex.cpp
+//============================================================================
+#ifndef _YEARINDEX_H
+#define _YEARINDEX_H
+
+#include "myvector.h"
+#include "book.h"
+
+//Entry of the year index, ordered by year and then by book address
+struct YearEntry
+{
+	int year;			//publication year the book was indexed with
+	bool removed;		//true once the book has been removed (dropped at the next merge)
+	Book* book;
+};
+
+//Ordered index over the publication years: a large sorted array plus a small delta of recent
+//additions that is merged into it once it grows past a fraction of the array. Only add, remove and
+//clear change the index, so searches can run concurrently with each other.
+class YearIndex
+{
+	private:
+		MyVector<YearEntry> main;		//sorted entries
+		MyVector<YearEntry> delta;		//recent entries; the first deltaSorted of them are sorted
+		int deltaSorted;				//length of the sorted prefix of delta
+		int removedCount;				//entries marked removed in main and delta
+
+		void sortDelta();				//sort the whole delta (appended entries are merged into the sorted prefix)
+		void merge();					//merge delta into main, dropping removed entries
+		YearEntry* findEntry(MyVector<YearEntry>& entries, int end, int year, Book* book);	//find the live entry of a book among the first end sorted entries
+
+	public:
+		YearIndex();
+
+		void add(Book* book);							//index a book under its publication year
+		void remove(Book* book, int year);				//remove a book indexed under the given year
+		void clear();									//remove every book
+		void search(int fromYear, int toYear, MyVector<Book*>& books) const;	//append the books published in [fromYear, toYear], in year order
+};
+
+#endif